@@ -0,0 +1,268 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the BatchKernel class template.
+ */
+
+#ifndef _BATCHKERNEL_H
+#define _BATCHKERNEL_H
+
+#include "TVector.h"
+#include "DoubleDoubleLanes.h"
+
+/**
+ * TableKernel<DoubleDouble> for N balls at once, each ball in its own lane
+ * of a DoubleDoubleLanes<N>. Every candidate collision is worked out for
+ * every lane and the right one chosen with Select, rather than branching,
+ * so the lanes run together in vector registers. The result in each lane
+ * is the same, bit for bit, as TableKernel<DoubleDouble> gives for that
+ * ball alone.
+ *
+ * The types and geometry follow CreateTable, as for TableKernel.
+ */
+template <int N>
+class BatchKernel
+{
+public:
+	typedef DoubleDoubleLanes<N> Lanes;
+	typedef LaneMask<N> Mask;
+
+	/**
+	 * Constructor from a table type and its geometry, as for CreateTable.
+	 *
+	 * int type: integer 1-5 specifying the type of table.
+	 * double params[]: array specifying the geometry of the table.
+	 */
+	BatchKernel(int type, const double params[]) :
+		fType(type), fA(params[0]), fB(0), fC(0)
+	{
+		if (type == 2 || type == 5)
+		{
+			fB = Lanes(params[1]);
+			fC = Lanes(params[2]);
+		}
+		else if (type == 3 || type == 4)
+		{
+			fB = Lanes(params[1]);
+		}
+	}
+
+	// Getters.
+	int GetType() const { return fType; }
+
+	/**
+	 * One lane of a vector of lanes.
+	 */
+	static TVector<DoubleDouble> GetLane(const TVector<Lanes> & vector, int lane)
+	{
+		return TVector<DoubleDouble>(vector.fX.Get(lane), vector.fY.Get(lane));
+	}
+	/**
+	 * Sets one lane of a vector of lanes.
+	 */
+	static void SetLane(TVector<Lanes> & vector, int lane, const TVector<DoubleDouble> & value)
+	{
+		vector.fX.Set(lane, value.fX);
+		vector.fY.Set(lane, value.fY);
+	}
+
+	/**
+	 * Moves every ball to its next collision and reflects it, as
+	 * TableKernel::Step. Lanes with no collision are left where they were.
+	 *
+	 * TVector<Lanes> & position: positions of the balls, set to the
+	 * collisions.
+	 * TVector<Lanes> & velocity: velocities of the balls, set to the
+	 * reflected velocities.
+	 * return: time taken by each ball, or -1 in lanes where the ball has
+	 * been lost.
+	 */
+	Lanes Step(TVector<Lanes> & position, TVector<Lanes> & velocity) const
+	{
+		TVector<Lanes> normal(Lanes(0), Lanes(0));
+		Lanes time = Collide(position, velocity, normal);
+
+		Mask found = time >= Lanes(0);
+
+		position = Select(found, position + time * velocity, position);
+		velocity = Select(found, velocity - Lanes(2) * velocity.Dot(normal) * normal, velocity);
+
+		return Lanes::Select(found, time, Lanes(-1));
+	}
+
+private:
+	/**
+	 * Finds the next collision of each ball and the unit normal there, as
+	 * TableKernel::Collide.
+	 */
+	Lanes Collide(const TVector<Lanes> & position, const TVector<Lanes> & velocity, TVector<Lanes> & normal) const
+	{
+		TVector<Lanes> origin(Lanes(0), Lanes(0));
+		Lanes best(-1);
+
+		switch (fType)
+		{
+			case 1:
+				best = ExitCircle(position, velocity, origin, fA);
+				normal = Centre(position + best * velocity, origin);
+				break;
+			case 2:
+			{
+				TVector<Lanes> p(position.fX / fB, position.fY / fC);
+				TVector<Lanes> v(velocity.fX / fB, velocity.fY / fC);
+				best = ExitCircle(p, v, origin, fA);
+
+				TVector<Lanes> hit = position + best * velocity;
+				normal = TVector<Lanes>(hit.fX / (fB * fB), hit.fY / (fC * fC));
+				normal = normal / normal.Mod();
+				break;
+			}
+			case 3:
+			case 5:
+				best = Walls(position, velocity, normal);
+
+				if (fType == 5)
+				{
+					//The scatterer is missed more often than not, so its
+					//normal is only worked out if some lane hits it.
+					Lanes time = EnterCircle(position, velocity, fC);
+					Mask hit = (time >= Lanes(0)) & (time < best);
+					if (hit.Any())
+					{
+						best = Lanes::Select(hit, time, best);
+						normal = Select(hit, Centre(position + time * velocity, origin), normal);
+					}
+				}
+				break;
+			case 4:
+			{
+				//As TableKernel, with each if turned into a mask on its
+				//candidate. Only one of the arcs can be chosen, so the arc
+				//normal is worked out once, for the hit that was kept.
+				Mask up = velocity.fY > Lanes(0);
+				Lanes wall = Lanes::Select(up, fB, -fB);
+				Lanes time = (wall - position.fY) / velocity.fY;
+				Lanes x = position.fX + time * velocity.fX;
+				Mask valid = (velocity.fY != Lanes(0)) & (time >= Lanes(0)) & (x <= fA) & (x >= -fA);
+				Candidate(valid, time, TVector<Lanes>(Lanes(0), Lanes::Select(up, Lanes(1), Lanes(-1))), best, normal);
+
+				Mask arc;
+				TVector<Lanes> arcHit = origin, arcCentre = origin;
+				for (int side = -1; side <= 1; side += 2)
+				{
+					TVector<Lanes> centre(Lanes(side) * fA, Lanes(0));
+					time = ExitCircle(position, velocity, centre, fB);
+					TVector<Lanes> hit = position + time * velocity;
+					valid = Lanes(side) * (hit.fX - centre.fX) >= Lanes(0);
+
+					Mask take = Earliest(valid, time, best);
+					best = Lanes::Select(take, time, best);
+					arcHit = Select(take, hit, arcHit);
+					arcCentre = Select(take, centre, arcCentre);
+					arc = arc | take;
+				}
+
+				normal = Select(arc, Centre(arcHit, arcCentre), normal);
+				break;
+			}
+		}
+
+		return best;
+	}
+
+	/**
+	 * Time for each ball inside a circle to reach its edge, as TableKernel.
+	 */
+	static Lanes ExitCircle(const TVector<Lanes> & position, const TVector<Lanes> & velocity, const TVector<Lanes> & centre, const Lanes & radius)
+	{
+		TVector<Lanes> p = position - centre;
+		Lanes a = velocity.Dot(velocity);
+		Lanes b = p.Dot(velocity);
+		Lanes c = p.Dot(p) - radius * radius;
+		Lanes d = b * b - a * c;
+
+		d = Lanes::Select(d < Lanes(0), Lanes(0), d);
+
+		return (-b + sqrt(d)) / a;
+	}
+
+	/**
+	 * Time for each ball outside a circle at the origin to hit it, as
+	 * TableKernel. -1 in lanes which miss or are moving away.
+	 */
+	static Lanes EnterCircle(const TVector<Lanes> & position, const TVector<Lanes> & velocity, const Lanes & radius)
+	{
+		Lanes a = velocity.Dot(velocity);
+		Lanes b = position.Dot(velocity);
+		Lanes c = position.Dot(position) - radius * radius;
+		Lanes d = b * b - a * c;
+
+		Mask miss = (b >= Lanes(0)) | (d <= Lanes(0));
+		if (miss.All())
+			return Lanes(-1);
+
+		return Lanes::Select(miss, Lanes(-1), (-b - sqrt(d)) / a);
+	}
+
+	/**
+	 * Time for each ball to reach the rectangle walls, as TableKernel.
+	 */
+	Lanes Walls(const TVector<Lanes> & position, const TVector<Lanes> & velocity, TVector<Lanes> & normal) const
+	{
+		Lanes best(-1);
+
+		Lanes wall = Lanes::Select(velocity.fX > Lanes(0), fA, -fA);
+		Candidate(velocity.fX != Lanes(0), (wall - position.fX) / velocity.fX, TVector<Lanes>(Lanes(1), Lanes(0)), best, normal);
+
+		wall = Lanes::Select(velocity.fY > Lanes(0), fB, -fB);
+		Candidate(velocity.fY != Lanes(0), (wall - position.fY) / velocity.fY, TVector<Lanes>(Lanes(0), Lanes(1)), best, normal);
+
+		return best;
+	}
+
+	/**
+	 * Lanes of valid where time is the earliest non-negative time yet, the
+	 * test of TableKernel::Candidate.
+	 */
+	static Mask Earliest(const Mask & valid, const Lanes & time, const Lanes & best)
+	{
+		return valid & (time >= Lanes(0)) & ((best < Lanes(0)) | (time < best));
+	}
+
+	/**
+	 * Keeps time and its normal in the lanes where it is the earliest yet,
+	 * as TableKernel::Candidate.
+	 */
+	static void Candidate(const Mask & valid, const Lanes & time, const TVector<Lanes> & candidate, Lanes & best, TVector<Lanes> & normal)
+	{
+		Mask take = Earliest(valid, time, best);
+
+		best = Lanes::Select(take, time, best);
+		normal = Select(take, candidate, normal);
+	}
+
+	/**
+	 * Unit vector from centre to point.
+	 */
+	static TVector<Lanes> Centre(const TVector<Lanes> & point, const TVector<Lanes> & centre)
+	{
+		TVector<Lanes> r = point - centre;
+		return r / r.Mod();
+	}
+
+	/**
+	 * Lane-wise choice of vectors, a where mask is on and b elsewhere.
+	 */
+	static TVector<Lanes> Select(const Mask & mask, const TVector<Lanes> & a, const TVector<Lanes> & b)
+	{
+		return TVector<Lanes>(Lanes::Select(mask, a.fX, b.fX), Lanes::Select(mask, a.fY, b.fY));
+	}
+
+	int fType;
+	// Geometry, in the order given to the constructor, in every lane.
+	Lanes fA;
+	Lanes fB;
+	Lanes fC;
+};
+
+#endif
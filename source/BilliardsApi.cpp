@@ -0,0 +1,144 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the C interface to the billiards library.
+ */
+
+#include <climits>
+
+#include "BilliardsApi.h"
+#include "TableFactory.h"
+#include "Parallel.h"
+#include "Birkhoff.h"
+#include "Vector.h"
+
+struct BilliardsTable
+{
+	ITable * fTable;
+};
+
+/**
+ * Runs one ball on for a number of bounces, optionally recording each.
+ */
+static void Advance(ITable & table, double * position, double * velocity, int bounces, double * time,
+	double * pathPosition, double * pathVelocity)
+{
+	Vector p(position[0], position[1]);
+	Vector v(velocity[0], velocity[1]);
+	Vector collision;
+	double speed = v.Mod();
+
+	for (int j = 0; j != bounces; j++)
+	{
+		collision = table.CollisionPoint(p, v);
+		if (time)
+			*time += (collision - p).Mod() / speed;
+
+		p = collision;
+		v = table.ReflectVector(p, v);
+
+		if (pathPosition)
+		{
+			pathPosition[2 * j] = p.fX;
+			pathPosition[2 * j + 1] = p.fY;
+		}
+		if (pathVelocity)
+		{
+			pathVelocity[2 * j] = v.fX;
+			pathVelocity[2 * j + 1] = v.fY;
+		}
+	}
+
+	position[0] = p.fX;
+	position[1] = p.fY;
+	velocity[0] = v.fX;
+	velocity[1] = v.fY;
+}
+
+BilliardsTable * BilliardsCreateTable(int type, const double * params)
+{
+	if (!params)
+		return 0;
+
+	ITable * table = CreateTable(type, params);
+	if (!table)
+		return 0;
+
+	BilliardsTable * handle = new BilliardsTable;
+	handle->fTable = table;
+
+	return handle;
+}
+
+void BilliardsDestroyTable(BilliardsTable * table)
+{
+	if (!table)
+		return;
+
+	delete table->fTable;
+	delete table;
+}
+
+double BilliardsBoundaryLength(BilliardsTable * table)
+{
+	return table ? table->fTable->BoundaryLength() : 0;
+}
+
+int BilliardsThreadCount()
+{
+	return ThreadCount();
+}
+
+int BilliardsStep(BilliardsTable * table, double * positions, double * velocities, long n, int bounces,
+	double * times)
+{
+	if (!table || !positions || !velocities || n < 0 || n > INT_MAX || bounces < 0)
+		return -1;
+
+	ITable & inner = *table->fTable;
+
+	//ParallelFor takes an int range, checked above.
+	ParallelFor((int) n, [&](int begin, int end, int thread)
+	{
+		for (long i = begin; i != end; i++)
+			Advance(inner, positions + 2 * i, velocities + 2 * i, bounces, times ? times + i : 0, 0, 0);
+	});
+
+	return 0;
+}
+
+int BilliardsTrajectory(BilliardsTable * table, double * positions, double * velocities, long n, int bounces,
+	double * pathPositions, double * pathVelocities)
+{
+	if (!table || !positions || !velocities || !pathPositions || n < 0 || n > INT_MAX || bounces < 0)
+		return -1;
+
+	ITable & inner = *table->fTable;
+
+	ParallelFor((int) n, [&](int begin, int end, int thread)
+	{
+		for (long i = begin; i != end; i++)
+			Advance(inner, positions + 2 * i, velocities + 2 * i, bounces, 0, pathPositions + 2 * i * bounces,
+				pathVelocities ? pathVelocities + 2 * i * bounces : 0);
+	});
+
+	return 0;
+}
+
+int BilliardsBirkhoff(BilliardsTable * table, const double * positions, const double * velocities, long n,
+	double * s, double * p)
+{
+	if (!table || !positions || !velocities || !s || !p || n < 0 || n > INT_MAX)
+		return -1;
+
+	ITable & inner = *table->fTable;
+
+	ParallelFor((int) n, [&](int begin, int end, int thread)
+	{
+		for (long i = begin; i != end; i++)
+			BirkhoffCoordinates(inner, Vector(positions[2 * i], positions[2 * i + 1]),
+				Vector(velocities[2 * i], velocities[2 * i + 1]), s[i], p[i]);
+	});
+
+	return 0;
+}
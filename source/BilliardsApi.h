@@ -0,0 +1,104 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the C interface to the billiards library (libbilliards).
+ */
+
+#ifndef _BILLIARDSAPI_H
+#define _BILLIARDSAPI_H
+
+/**
+ * Plain C functions for driving the simulation from other programs and
+ * languages (e.g. Python with ctypes and numpy), built into the shared
+ * library libbilliards. Ball states are passed as caller-owned contiguous
+ * arrays of n (x, y) pairs, x0 y0 x1 y1 ..., which are read and updated in
+ * place; nothing is copied and no files are written.
+ *
+ * Functions returning int give 0 on success and -1 for bad arguments,
+ * including more than INT_MAX balls.
+ *
+ * The batch functions share one pool of worker threads. They can be called
+ * from several threads at once, but such calls take turns rather than
+ * running side by side.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Handle for a table made by BilliardsCreateTable.
+typedef struct BilliardsTable BilliardsTable;
+
+/**
+ * Creates a table, as CreateTable.
+ *
+ * int type: 1=circular 2=elliptical 3=rectangular 4=stadium 5=lorentz.
+ * double * params: table geometry, as for CreateTable.
+ * return: new table, or NULL for an unknown type.
+ */
+BilliardsTable * BilliardsCreateTable(int type, const double * params);
+
+/**
+ * Deletes a table made by BilliardsCreateTable.
+ */
+void BilliardsDestroyTable(BilliardsTable * table);
+
+/**
+ * Total length of the table edge, the range of the arc length s.
+ */
+double BilliardsBoundaryLength(BilliardsTable * table);
+
+/**
+ * Number of threads used by the batch functions.
+ */
+int BilliardsThreadCount();
+
+/**
+ * Moves every ball on by a number of bounces, in parallel. After the call
+ * positions holds the last collision point of each ball and velocities the
+ * velocity leaving it.
+ *
+ * BilliardsTable * table: table to run on.
+ * double * positions: n (x, y) positions, updated in place.
+ * double * velocities: n (x, y) velocities, updated in place.
+ * long n: number of balls, at most INT_MAX.
+ * int bounces: bounces for each ball.
+ * double * times: n flight times, each increased by the time taken, or
+ * NULL if not wanted.
+ * return: 0, or -1 for bad arguments.
+ */
+int BilliardsStep(BilliardsTable * table, double * positions, double * velocities, long n, int bounces,
+	double * times);
+
+/**
+ * Runs each ball for a number of bounces, storing every collision point
+ * rather than just the last. Output arrays are n * bounces (x, y) pairs,
+ * ball by ball. positions and velocities are left at the final state, as
+ * for BilliardsStep.
+ *
+ * double * pathPositions: n * bounces (x, y) collision points to fill.
+ * double * pathVelocities: n * bounces (x, y) velocities leaving them, or
+ * NULL if not wanted.
+ * return: 0, or -1 for bad arguments.
+ */
+int BilliardsTrajectory(BilliardsTable * table, double * positions, double * velocities, long n, int bounces,
+	double * pathPositions, double * pathVelocities);
+
+/**
+ * Birkhoff coordinates (see BirkhoffCoordinates) of n balls sitting on the
+ * table edge, e.g. after BilliardsStep.
+ *
+ * double * positions: n (x, y) collision points.
+ * double * velocities: n (x, y) velocities.
+ * double * s: n arc lengths to fill.
+ * double * p: n sines of the reflection angle to fill.
+ * return: 0, or -1 for bad arguments.
+ */
+int BilliardsBirkhoff(BilliardsTable * table, const double * positions, const double * velocities, long n,
+	double * s, double * p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
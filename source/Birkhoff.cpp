@@ -0,0 +1,18 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the Birkhoff coordinate functions.
+ */
+
+#include "Birkhoff.h"
+
+void BirkhoffCoordinates(ITable & table, const Vector & collision, const Vector & velocity, double & s, double & p)
+{
+	Vector norm = table.Normal(collision);
+
+	//Tangent is the normal rotated by -pi/2.
+	Vector tangent(norm.fY, -norm.fX);
+
+	s = table.BoundaryPosition(collision);
+	p = velocity.Dot(tangent) / velocity.Mod();
+}
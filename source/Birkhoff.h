@@ -0,0 +1,30 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the Birkhoff coordinate functions.
+ */
+
+#ifndef _BIRKHOFF_H
+#define _BIRKHOFF_H
+
+#include "ITable.h"
+
+/**
+ * Birkhoff coordinates describe a bounce by where it happens and at what
+ * angle: s is the arc length round the table edge (ITable::BoundaryPosition)
+ * and p is the sine of the angle between the velocity leaving the wall and
+ * the inward normal, positive when heading in the direction of increasing s.
+ *
+ * In these coordinates the bounce map preserves area, so phase portraits
+ * plotted in (s, p) show ergodic tables as a uniform density.
+ *
+ * ITable & table: billiard table.
+ * Vector & collision: point of collision with the wall of the table.
+ * Vector & velocity: velocity after reflection (or before, the tangential
+ * component is the same).
+ * double & s: set to the arc length coordinate.
+ * double & p: set to the sine of the reflection angle.
+ */
+void BirkhoffCoordinates(ITable & table, const Vector & collision, const Vector & velocity, double & s, double & p);
+
+#endif
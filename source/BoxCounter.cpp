@@ -0,0 +1,119 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the BoxCounter class.
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include "BoxCounter.h"
+
+/**
+ * Spreads the low 16 bits of x out to the even bits.
+ */
+static uint32_t Spread(uint32_t x)
+{
+	x = (x | (x << 8)) & 0x00FF00FF;
+	x = (x | (x << 4)) & 0x0F0F0F0F;
+	x = (x | (x << 2)) & 0x33333333;
+	x = (x | (x << 1)) & 0x55555555;
+	return x;
+}
+
+BoxCounter::BoxCounter() :
+	fLevels(0), fXMin(0), fYMin(0), fXScale(0), fYScale(0), fSorted(0)
+{}
+
+BoxCounter::BoxCounter(int levels, double xMin, double xMax, double yMin, double yMax) :
+	fLevels(std::min(levels, 16)), fXMin(xMin), fYMin(yMin), fSorted(0)
+{
+	fXScale = (1 << fLevels) / (xMax - xMin);
+	fYScale = (1 << fLevels) / (yMax - yMin);
+}
+
+BoxCounter::~BoxCounter()
+{}
+
+void BoxCounter::Add(double x, double y)
+{
+	double i = (x - fXMin) * fXScale;
+	double j = (y - fYMin) * fYScale;
+	double size = 1 << fLevels;
+
+	//Written so NaNs fail the test too.
+	if (!(i >= 0 && i < size && j >= 0 && j < size))
+		return;
+
+	fCells.push_back(Spread((uint32_t) i) | (Spread((uint32_t) j) << 1));
+
+	//Long runs mostly revisit boxes, so keep the list short.
+	if (fCells.size() > 2 * fSorted + 65536)
+		Compact();
+}
+
+void BoxCounter::Merge(const BoxCounter & other)
+{
+	fCells.insert(fCells.end(), other.fCells.begin(), other.fCells.end());
+	Compact();
+}
+
+void BoxCounter::Clear()
+{
+	fCells.clear();
+	fSorted = 0;
+}
+
+int BoxCounter::Count(int level)
+{
+	Compact();
+
+	//Codes stay sorted after dropping low bits, so repeats are adjacent.
+	int shift = 2 * (fLevels - level);
+	int count = 0;
+
+	for (unsigned int k = 0; k != fCells.size(); k++)
+	{
+		if (k == 0 || (fCells[k] >> shift) != (fCells[k-1] >> shift))
+			count++;
+	}
+
+	return count;
+}
+
+double BoxCounter::Dimension(int minLevel, int maxLevel)
+{
+	double sx = 0, sy = 0, sxx = 0, sxy = 0;
+	int points = 0;
+
+	for (int level = minLevel; level <= maxLevel && level <= fLevels; level++)
+	{
+		int count = Count(level);
+		if (count == 0)
+			continue;
+
+		double x = level * std::log(2.0);
+		double y = std::log((double) count);
+
+		sx += x;
+		sy += y;
+		sxx += x * x;
+		sxy += x * y;
+		points++;
+	}
+
+	if (points < 2)
+		return 0;
+
+	return (points * sxy - sx * sy) / (points * sxx - sx * sx);
+}
+
+void BoxCounter::Compact()
+{
+	if (fSorted == fCells.size())
+		return;
+
+	std::sort(fCells.begin(), fCells.end());
+	fCells.erase(std::unique(fCells.begin(), fCells.end()), fCells.end());
+	fSorted = fCells.size();
+}
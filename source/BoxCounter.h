@@ -0,0 +1,99 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the BoxCounter class.
+ */
+
+#ifndef _BOXCOUNTER_H
+#define _BOXCOUNTER_H
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * Box counting estimate of the fractal dimension of a set of points, as done
+ * by the DimensionCalculator script but without keeping the points. The
+ * region is covered by grids of 2^level boxes a side, for level 0 up to
+ * levels, and the number of boxes holding at least one point is counted at
+ * each level. The dimension is the slope of log count against log of the
+ * boxes per side.
+ *
+ * Occupied boxes of the finest grid are stored in Morton (Z) order, so each
+ * coarser grid's box is found by dropping the low bits.
+ */
+class BoxCounter
+{
+public:
+	/**
+	 * Empty constructor, no levels.
+	 */
+	BoxCounter();
+	/**
+	 * Constructor for the region xMin-xMax by yMin-yMax.
+	 *
+	 * int levels: finest grid has 2^levels boxes a side, at most 16.
+	 */
+	BoxCounter(int levels, double xMin, double xMax, double yMin, double yMax);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~BoxCounter();
+
+	/**
+	 * Adds a point. Points outside the region are ignored.
+	 */
+	void Add(double x, double y);
+
+	/**
+	 * Adds the points of another counter over the same region and levels.
+	 */
+	void Merge(const BoxCounter & other);
+
+	/**
+	 * Removes all points.
+	 */
+	void Clear();
+
+	/**
+	 * Number of occupied boxes on one of the grids.
+	 *
+	 * int level: grid with 2^level boxes a side.
+	 * return: number of boxes with at least one point in.
+	 */
+	int Count(int level);
+
+	/**
+	 * Least squares slope of log Count(level) against log 2^level, over a
+	 * range of levels. Only levels with many more points than boxes give a
+	 * fair count, so the range should stop well short of the finest grid
+	 * for short runs.
+	 *
+	 * int minLevel: first level to fit.
+	 * int maxLevel: last level to fit.
+	 * return: box dimension estimate.
+	 */
+	double Dimension(int minLevel, int maxLevel);
+
+	// Getters.
+	int GetLevels() const { return fLevels; }
+
+private:
+	/**
+	 * Sorts the stored boxes and removes repeats.
+	 */
+	void Compact();
+
+	int fLevels;
+	double fXMin;
+	double fYMin;
+
+	// Finest grid boxes per unit length.
+	double fXScale;
+	double fYScale;
+
+	// Morton codes of occupied finest boxes, sorted and unique up to fSorted.
+	std::vector<uint32_t> fCells;
+	unsigned int fSorted;
+};
+
+#endif
@@ -29,7 +29,7 @@ Vector CircleTable::ReflectVector(const Vector & collision, const Vector & veloc
 	//See report for details.
 	Vector temp;
 
-	temp = velocity - 2*(velocity.Dot(-collision)*(-collision))/collision.Mod();
+	temp = velocity - 2*(velocity.Dot(-collision)*(-collision))/collision.Dot(collision);
 
 	return temp;
 }
@@ -49,3 +49,31 @@ Vector CircleTable::CollisionPoint(const Vector & initial, const Vector & veloci
 
 	return initial + gamma * velocity;
 }
+
+double CircleTable::BoundaryPosition(const Vector & collision)
+{
+	//Arc length is just radius times polar angle.
+	double angle = std::atan2(collision.fY, collision.fX);
+
+	if (angle < 0)
+		angle += 2*M_PI;
+
+	return fRadius * angle;
+}
+
+double CircleTable::BoundaryLength()
+{
+	return 2*M_PI*fRadius;
+}
+
+Vector CircleTable::BoundaryPoint(double s)
+{
+	double angle = s / fRadius;
+
+	return Vector(fRadius * std::cos(angle), fRadius * std::sin(angle));
+}
+
+Vector CircleTable::Normal(const Vector & collision)
+{
+	return -collision / collision.Mod();
+}
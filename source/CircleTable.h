@@ -36,6 +36,14 @@ public:
 	double AngleIncidence(const Vector & collision, const Vector & velocity);
 	Vector ReflectVector(const Vector & collision, const Vector & velocity);
 	Vector CollisionPoint(const Vector & initial, const Vector & velocity); 
+	// Boundary coordinate starts at (r,0) and runs anticlockwise.
+	double BoundaryPosition(const Vector & collision);
+	double BoundaryLength();
+	Vector BoundaryPoint(double s);
+	Vector Normal(const Vector & collision);
+	int Component(const Vector & collision) { return 0; }
+	int ComponentCount() { return 1; }
+	double Curvature(const Vector & collision) { return 1 / fRadius; }
 private:
 	// Circular table is parameterised by a radius, and has centre at
 	// (0,0).
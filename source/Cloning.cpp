@@ -0,0 +1,160 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the Cloning class.
+ */
+
+#include <cmath>
+#include <ctime>
+#include <algorithm>
+
+#include "Cloning.h"
+#include "Parallel.h"
+
+Cloning::Cloning(ITable & table, int interval, double noise) :
+	fTable(&table), fInterval(interval > 0 ? interval : 1), fNoise(noise), fSCGF(0), fLyapunov(0), fClones(0)
+{
+	for (int t = 0; t != ThreadCount(); t++)
+		fEngines.push_back(std::default_random_engine(std::time(0) + 7919 * t));
+}
+
+Cloning::~Cloning()
+{}
+
+void Cloning::Add(const Vector & position, const Vector & velocity)
+{
+	//Unit speed, and a tangent vector across the direction of flight.
+	Walker walker;
+	walker.fPosition = position;
+	walker.fVelocity = velocity / velocity.Mod();
+	walker.fTangent = Tangent(Vector(-walker.fVelocity.fY, walker.fVelocity.fX), Vector(0, 0));
+
+	fWalkers.push_back(walker);
+}
+
+void Cloning::Run(double s, int resamplings)
+{
+	int settle = resamplings / 10;
+	double sumMean = 0, sumLyapunov = 0, sumClones = 0;
+
+	for (int r = 0; r != resamplings; r++)
+	{
+		Evolve();
+
+		double mean, lyapunov;
+		Resample(s, mean, lyapunov);
+
+		if (r >= settle)
+		{
+			sumMean += mean;
+			sumLyapunov += lyapunov;
+			sumClones += fClones;
+		}
+	}
+
+	int counted = resamplings - settle;
+	fSCGF = counted > 0 ? sumMean / counted : 0;
+	fLyapunov = counted > 0 ? sumLyapunov / counted : 0;
+	fClones = counted > 0 ? sumClones / counted : 0;
+}
+
+void Cloning::Evolve()
+{
+	int n = fWalkers.size();
+	fStretch.resize(n);
+
+	ParallelFor(n, [&](int begin, int end, int thread)
+	{
+		for (int i = begin; i != end; i++)
+		{
+			Walker & walker = fWalkers[i];
+
+			for (int j = 0; j != fInterval; j++)
+			{
+				Vector collision = fTable->CollisionPoint(walker.fPosition, walker.fVelocity);
+
+				walker.fTangent.Flight((collision - walker.fPosition).Mod());
+				walker.fTangent.Bounce(*fTable, collision, walker.fVelocity);
+
+				walker.fVelocity = fTable->ReflectVector(collision, walker.fVelocity);
+				walker.fPosition = collision;
+			}
+
+			//Stretching over the interval, then back to unit length.
+			double length = walker.fTangent.Mod();
+			fStretch[i] = std::log(length);
+			walker.fTangent = walker.fTangent * (1 / length);
+		}
+	});
+}
+
+void Cloning::Resample(double s, double & mean, double & lyapunov)
+{
+	int n = fWalkers.size();
+
+	//Weights relative to the largest, so they can't overflow.
+	double largest = s * fStretch[0];
+	for (int i = 1; i != n; i++)
+		largest = std::max(largest, s * fStretch[i]);
+
+	fWeights.resize(n);
+	std::vector<double> weighted(n);
+
+	ParallelFor(n, [&](int begin, int end, int thread)
+	{
+		for (int i = begin; i != end; i++)
+		{
+			fWeights[i] = std::exp(s * fStretch[i] - largest);
+			weighted[i] = fWeights[i] * fStretch[i];
+		}
+	});
+
+	ParallelPrefixSum(fWeights);
+	ParallelPrefixSum(weighted);
+
+	double total = fWeights[n - 1];
+	mean = (std::log(total / n) + largest) / fInterval;
+	lyapunov = weighted[n - 1] / total / fInterval;
+
+	//Systematic resampling: walker i takes the places j of the new
+	//population with (j + u) total / n between the sums before and up to i.
+	std::uniform_real_distribution<double> uniform(0, 1);
+	double u = uniform(fEngines[0]);
+	double scale = n / total;
+	std::vector<int> copies(ThreadCount(), 0);
+
+	fNext.resize(n);
+
+	ParallelFor(n, [&](int begin, int end, int thread)
+	{
+		std::normal_distribution<double> turn(0, fNoise);
+
+		for (int i = begin; i != end; i++)
+		{
+			int first = (int) std::ceil((i > 0 ? fWeights[i - 1] : 0) * scale - u);
+			int last = std::min(n, (int) std::ceil(fWeights[i] * scale - u));
+
+			for (int j = std::max(first, 0); j < last; j++)
+			{
+				fNext[j] = fWalkers[i];
+
+				//Every copy after the first is turned slightly.
+				if (j > first && fNoise > 0)
+				{
+					double angle = turn(fEngines[thread]);
+					Vector v = fNext[j].fVelocity;
+					fNext[j].fVelocity = Vector(v.fX * std::cos(angle) - v.fY * std::sin(angle),
+						v.fX * std::sin(angle) + v.fY * std::cos(angle));
+					copies[thread]++;
+				}
+			}
+		}
+	});
+
+	fWalkers.swap(fNext);
+
+	long copied = 0;
+	for (unsigned int t = 0; t != copies.size(); t++)
+		copied += copies[t];
+	fClones = (double) copied / n;
+}
@@ -0,0 +1,121 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the Cloning class.
+ */
+
+#ifndef _CLONING_H
+#define _CLONING_H
+
+#include <vector>
+#include <random>
+
+#include "ITable.h"
+#include "Tangent.h"
+
+/**
+ * Population dynamics (cloning) estimate of the large deviations of the
+ * finite time Lyapunov exponent. Trajectories with unusually little or much
+ * stretching (e.g. stuck bouncing between the flat walls of the stadium)
+ * are too rare to see in a plain run; here a population of walkers is run
+ * in parallel, and after every few bounces each walker is copied or dropped
+ * according to a weight exp(s a), where a is how much its tangent vector
+ * stretched (in log) over those bounces. For s > 0 this favours the more
+ * chaotic walkers, for s < 0 the less chaotic.
+ *
+ * The mean weight at each resampling gives the scaled cumulant generating
+ * function psi(s) = lim 1/n ln E[exp(s A_n)] of the stretching A_n over n
+ * bounces, and the mean stretching of the walkers kept gives the Lyapunov
+ * exponent typical of the trajectories with that bias, psi'(s).
+ *
+ * The population is resampled systematically: the weights are summed with
+ * a parallel prefix sum, so each walker knows which places in the new
+ * population are its copies and writes them itself. Copies are nudged by a
+ * tiny random turn of the velocity, or they would stay together forever.
+ */
+class Cloning
+{
+public:
+	/**
+	 * Constructor, for an empty population.
+	 *
+	 * ITable & table: table to run on.
+	 * int interval: bounces between resamplings.
+	 * double noise: size of the random turn given to copies, in radians.
+	 */
+	Cloning(ITable & table, int interval, double noise);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~Cloning();
+
+	// Getters.
+	int GetSize() const { return fWalkers.size(); }
+	double GetSCGF() const { return fSCGF; }
+	double GetLyapunov() const { return fLyapunov; }
+	double GetClones() const { return fClones; }
+
+	/**
+	 * Adds a walker.
+	 *
+	 * Vector & position, & velocity: starting state.
+	 */
+	void Add(const Vector & position, const Vector & velocity);
+
+	/**
+	 * Runs the population with bias s. The first tenth of the resamplings
+	 * let the population settle, and the rest are averaged for the
+	 * estimates.
+	 *
+	 * double s: bias, 0 for the unbiased dynamics.
+	 * int resamplings: number of resamplings.
+	 */
+	void Run(double s, int resamplings);
+
+private:
+	/**
+	 * A trajectory and the tangent vector carried along it.
+	 */
+	struct Walker
+	{
+		Vector fPosition;
+		Vector fVelocity;
+		Tangent fTangent;
+	};
+
+	/**
+	 * Runs every walker on fInterval bounces in parallel, setting its
+	 * stretching.
+	 */
+	void Evolve();
+
+	/**
+	 * Replaces the population with a new one of the same size, each walker
+	 * copied in proportion to its weight.
+	 *
+	 * double s: bias.
+	 * double & mean: set to ln of the mean weight, per bounce.
+	 * double & lyapunov: set to the weighted mean stretching, per bounce.
+	 */
+	void Resample(double s, double & mean, double & lyapunov);
+
+	ITable * fTable;
+	int fInterval;
+	double fNoise;
+
+	std::vector<Walker> fWalkers;
+	std::vector<Walker> fNext;
+	std::vector<double> fStretch;
+	std::vector<double> fWeights;
+
+	// One random engine per thread, for the noise.
+	std::vector<std::default_random_engine> fEngines;
+
+	// Results of the last Run, and the mean fraction of walkers which were
+	// copies of another at each resampling.
+	double fSCGF;
+	double fLyapunov;
+	double fClones;
+};
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the Autocorrelation and BlockAutocorrelation classes.
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include "Correlation.h"
+
+void FFT(std::vector<std::complex<double> > & data, bool inverse)
+{
+	int n = data.size();
+
+	//Bit reversed order.
+	for (int i = 1, j = 0; i < n; i++)
+	{
+		int bit = n >> 1;
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+
+		if (i < j)
+			std::swap(data[i], data[j]);
+	}
+
+	for (int length = 2; length <= n; length <<= 1)
+	{
+		double angle = 2 * M_PI / length * (inverse ? 1 : -1);
+		std::complex<double> step(std::cos(angle), std::sin(angle));
+
+		for (int start = 0; start < n; start += length)
+		{
+			std::complex<double> w(1);
+			for (int k = 0; k != length / 2; k++)
+			{
+				std::complex<double> even = data[start + k];
+				std::complex<double> odd = data[start + k + length / 2] * w;
+				data[start + k] = even + odd;
+				data[start + k + length / 2] = even - odd;
+				w *= step;
+			}
+		}
+	}
+
+	if (inverse)
+	{
+		for (int i = 0; i != n; i++)
+			data[i] /= n;
+	}
+}
+
+/**
+ * Turns sums of products at each lag into correlations.
+ */
+static void Normalise(const std::vector<double> & products, long count, double sum, std::vector<double> & correlation)
+{
+	correlation.assign(products.size(), 0);
+
+	if (count < 2)
+		return;
+
+	double mean = sum / count;
+	double variance = products[0] / count - mean * mean;
+
+	for (unsigned int k = 0; k != products.size() && (long) k < count && variance > 0; k++)
+		correlation[k] = (products[k] / (count - k) - mean * mean) / variance;
+}
+
+Autocorrelation::Autocorrelation(int maxLag) :
+	fMaxLag(maxLag > 0 ? maxLag : 1), fCount(0), fSum(0), fRing(fMaxLag + 1, 0), fLast(0), fProducts(fMaxLag + 1, 0)
+{}
+
+Autocorrelation::~Autocorrelation()
+{}
+
+void Autocorrelation::Add(double x)
+{
+	fLast = (fLast + 1) % fRing.size();
+	fRing[fLast] = x;
+	fCount++;
+	fSum += x;
+
+	int lags = std::min((long) fMaxLag, fCount - 1);
+	for (int k = 0, i = fLast; k <= lags; k++)
+	{
+		fProducts[k] += x * fRing[i];
+		i = i > 0 ? i - 1 : fRing.size() - 1;
+	}
+}
+
+void Autocorrelation::Correlations(std::vector<double> & correlation) const
+{
+	Normalise(fProducts, fCount, fSum, correlation);
+}
+
+BlockAutocorrelation::BlockAutocorrelation(int maxLag) :
+	fBlock(1), fCount(0), fSum(0), fFill(0)
+{
+	while (fBlock < maxLag)
+		fBlock <<= 1;
+
+	fPrevious.assign(fBlock, 0);
+	fCurrent.assign(fBlock, 0);
+	fProducts.assign(fBlock + 1, 0);
+}
+
+BlockAutocorrelation::~BlockAutocorrelation()
+{}
+
+void BlockAutocorrelation::Add(double x)
+{
+	fCurrent[fFill++] = x;
+	fCount++;
+	fSum += x;
+
+	if (fFill == fBlock)
+	{
+		Correlate(fProducts);
+
+		fPrevious.swap(fCurrent);
+		fFill = 0;
+	}
+}
+
+void BlockAutocorrelation::Correlate(std::vector<double> & products) const
+{
+	//c(m) = sum over j of y(j) z(j + m), with y the current block and z the
+	//previous block followed by the current one. Lag k is c(B - k). Padded
+	//to 4B, so the circular correlation doesn't wrap.
+	//
+	//y and z are both real, so they are transformed together as the real
+	//and imaginary parts of one array, and separated afterwards.
+	int n = 4 * fBlock;
+	std::vector<std::complex<double> > data(n, 0);
+
+	for (int j = 0; j != fFill; j++)
+	{
+		data[j] += fCurrent[j];
+		data[fBlock + j] += std::complex<double>(0, fCurrent[j]);
+	}
+	//Before the first block is complete there is nothing before it.
+	if (fCount > fFill)
+	{
+		for (int j = 0; j != fBlock; j++)
+			data[j] += std::complex<double>(0, fPrevious[j]);
+	}
+
+	FFT(data, false);
+
+	std::vector<std::complex<double> > c(n);
+	for (int i = 0; i != n; i++)
+	{
+		std::complex<double> mirror = std::conj(data[(n - i) % n]);
+		std::complex<double> y = (data[i] + mirror) * 0.5;
+		std::complex<double> z = (data[i] - mirror) * std::complex<double>(0, -0.5);
+		c[i] = z * std::conj(y);
+	}
+	FFT(c, true);
+
+	for (int k = 0; k <= fBlock; k++)
+		products[k] += c[fBlock - k].real();
+}
+
+void BlockAutocorrelation::Correlations(std::vector<double> & correlation) const
+{
+	//Include the partly full block.
+	std::vector<double> products(fProducts);
+	if (fFill > 0)
+		Correlate(products);
+
+	Normalise(products, fCount, fSum, correlation);
+}
@@ -0,0 +1,134 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the Autocorrelation and BlockAutocorrelation classes.
+ */
+
+#ifndef _CORRELATION_H
+#define _CORRELATION_H
+
+#include <complex>
+#include <vector>
+
+/**
+ * In place fast Fourier transform, radix 2.
+ *
+ * std::vector<std::complex<double> > & data: values to transform, the size
+ * must be a power of 2.
+ * bool inverse: true for the inverse transform, which is scaled by 1/size.
+ */
+void FFT(std::vector<std::complex<double> > & data, bool inverse);
+
+/**
+ * Autocorrelation of a sequence of values up to a maximum lag, added one at
+ * a time. The last values are kept in a ring buffer, and each new value is
+ * multiplied by every one of them, so the cost per value grows with the
+ * maximum lag but the memory doesn't grow with the sequence.
+ *
+ * The correlation at lag k is the mean of x(t) x(t - k) less the mean
+ * squared, divided by the variance, so it is 1 at lag 0.
+ */
+class Autocorrelation
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * int maxLag: largest lag.
+	 */
+	Autocorrelation(int maxLag);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~Autocorrelation();
+
+	// Getters.
+	int GetMaxLag() const { return fMaxLag; }
+	long GetCount() const { return fCount; }
+
+	/**
+	 * Adds the next value.
+	 */
+	void Add(double x);
+
+	/**
+	 * Correlations at every lag.
+	 *
+	 * std::vector<double> & correlation: set to the correlation at lags 0
+	 * to the maximum, 0 where there are too few values.
+	 */
+	void Correlations(std::vector<double> & correlation) const;
+
+private:
+	int fMaxLag;
+	long fCount;
+	double fSum;
+
+	// Last values, with the newest at fLast, and sums of the products at
+	// each lag.
+	std::vector<double> fRing;
+	int fLast;
+	std::vector<double> fProducts;
+};
+
+/**
+ * As Autocorrelation, but for large lags: values are gathered into blocks
+ * as long as the maximum lag, and when a block is full its products with
+ * itself and the block before are found at every lag at once by FFT. The
+ * cost per value grows only with the log of the maximum lag. Two blocks are
+ * kept, so memory doesn't grow with the sequence either.
+ *
+ * Products in the last, partly full block are only counted by Correlations.
+ */
+class BlockAutocorrelation
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * int maxLag: largest lag, rounded up to a power of 2.
+	 */
+	BlockAutocorrelation(int maxLag);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~BlockAutocorrelation();
+
+	// Getters.
+	int GetMaxLag() const { return fBlock; }
+	long GetCount() const { return fCount; }
+
+	/**
+	 * Adds the next value.
+	 */
+	void Add(double x);
+
+	/**
+	 * Correlations at every lag.
+	 *
+	 * std::vector<double> & correlation: set to the correlation at lags 0
+	 * to the maximum, 0 where there are too few values.
+	 */
+	void Correlations(std::vector<double> & correlation) const;
+
+private:
+	/**
+	 * Adds the products of the current block, with fFill values, with itself
+	 * and the previous block to products.
+	 */
+	void Correlate(std::vector<double> & products) const;
+
+	int fBlock;
+	long fCount;
+	double fSum;
+
+	// Previous block, current block and values in it.
+	std::vector<double> fPrevious;
+	std::vector<double> fCurrent;
+	int fFill;
+
+	// Sums of the products at each lag over the complete blocks.
+	std::vector<double> fProducts;
+};
+
+#endif
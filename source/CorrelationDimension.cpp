@@ -0,0 +1,248 @@
+/**
+ * 19/10/2026
+ *
+ * Correlation dimension of a fractal data set, as written by the fractal
+ * modes of the simulation. A native replacement for the DimensionCalculator
+ * script which can cope with files of tens of millions of points.
+ *
+ * Usage: CorrelationDimension datafile [radii [rmin rmax [centres]]]
+ *
+ * The points are read from the xVec and yVec columns (or the first two
+ * columns if there are none), the correlation sum C(r) is counted (see
+ * CorrelationSum) and written to 'cordim.dat' with its local slopes, and
+ * the fitted dimension is printed.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "CorrelationSum.h"
+#include "Parallel.h"
+
+/**
+ * Reads two columns of a data file with a header line into points.
+ * Lines which can't be read are skipped.
+ *
+ * char * name: file to read.
+ * std::vector<double> & x, & y: points are added to these.
+ * double & width: set to the larger side of the box holding the points.
+ * return: false if the file couldn't be opened.
+ */
+bool ReadPoints(const char * name, std::vector<double> & x, std::vector<double> & y, double & width);
+
+/**
+ * Picks out the column numbers of xVec and yVec from a header line.
+ *
+ * char * header: header line.
+ * int & xColumn, & yColumn: set to the columns, or 0 and 1 if not found.
+ */
+void FindColumns(const char * header, int & xColumn, int & yColumn);
+
+int main(int argc, char * argv[])
+{
+	if (argc < 2)
+	{
+		printf("Usage: %s datafile [radii [rmin rmax [centres]]]\n", argv[0]);
+		printf("Defaults: 16 radii from rmax / 1000 up to rmax = 1%% of the size of the set,\n");
+		printf("counted from 100000 of the points (0 centres for every point).\n");
+		return 1;
+	}
+
+	int radii = argc > 2 ? std::atoi(argv[2]) : 16;
+	double rMin = argc > 4 ? std::atof(argv[3]) : 0;
+	double rMax = argc > 4 ? std::atof(argv[4]) : 0;
+	int centres = argc > 5 ? std::atoi(argv[5]) : 100000;
+
+	if (radii < 2 || (argc > 4 && (rMin <= 0 || rMax <= rMin)))
+	{
+		printf("Need at least 2 radii and 0 < rmin < rmax.\n");
+		return 1;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<double> x, y;
+	double width;
+
+	printf("Reading '%s'...\n", argv[1]);
+	if (!ReadPoints(argv[1], x, y, width))
+	{
+		printf("Couldn't read '%s'.\n", argv[1]);
+		return 1;
+	}
+
+	double read = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	printf("%lu points read in %.2f s.\n", (unsigned long) x.size(), read);
+
+	if (x.size() < 2)
+	{
+		printf("Need at least two points.\n");
+		return 1;
+	}
+
+	if (argc <= 4)
+	{
+		rMax = width / 100;
+		rMin = rMax / 1000;
+	}
+
+	CorrelationSum sum(rMin, rMax, radii);
+	for (unsigned long i = 0; i != x.size(); i++)
+		sum.Add(x[i], y[i]);
+
+	//The sum keeps its own copy.
+	std::vector<double>().swap(x);
+	std::vector<double>().swap(y);
+
+	printf("Counting pairs from %g to %g on %i threads...\n", rMin, rMax, ThreadCount());
+	start = std::chrono::steady_clock::now();
+
+	sum.Count(centres);
+
+	double counted = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	printf("%li centres, %li grid cells, %.2f s.\n", sum.GetCentres(), sum.GetCells(), counted);
+
+	FILE * file;
+	file = fopen("cordim.dat", "w");
+	if (!file)
+	{
+		printf("Couldn't write 'cordim.dat'.\n");
+		return 1;
+	}
+
+	fprintf(file, "%-24s%-24s%-24s%-24s\n", "r", "C", "pairs", "slope");
+	for (int k = 0; k != sum.GetRadii(); k++)
+		fprintf(file, "%-24.15g%-24.15g%-24lli%-24.15f\n", sum.GetRadius(k), sum.Sum(k), sum.GetPairs(k), sum.Slope(k));
+
+	fclose(file);
+
+	//Few pairs give a noisy count, so the fit starts once there are enough.
+	int first = 0;
+	while (first < sum.GetRadii() && sum.GetPairs(first) < 1000)
+		first++;
+
+	if (sum.GetRadii() - first >= 2)
+	{
+		printf("\nCorrelation dimension %f (radii %g to %g).\n", sum.Dimension(first, sum.GetRadii() - 1),
+			sum.GetRadius(first), rMax);
+	}
+	else
+	{
+		printf("\nToo few pairs to fit; try larger radii.\n");
+	}
+	printf("Fit over all radii with pairs: %f.\n", sum.Dimension(0, sum.GetRadii() - 1));
+
+	printf("\nWritten to 'cordim.dat'.\n");
+
+	return 0;
+}
+
+bool ReadPoints(const char * name, std::vector<double> & x, std::vector<double> & y, double & width)
+{
+	FILE * file;
+	file = fopen(name, "r");
+	if (!file)
+		return false;
+
+	std::vector<char> line(4096);
+	int xColumn = 0, yColumn = 1;
+
+	if (fgets(&line[0], line.size(), file))
+		FindColumns(&line[0], xColumn, yColumn);
+
+	double xMin = HUGE_VAL, xMax = -HUGE_VAL, yMin = HUGE_VAL, yMax = -HUGE_VAL;
+	int last = std::max(xColumn, yColumn);
+
+	while (fgets(&line[0], line.size(), file))
+	{
+		//Only the columns up to the last wanted are parsed.
+		char * p = &line[0];
+		double px = 0, py = 0;
+		bool read = true;
+
+		for (int c = 0; c <= last; c++)
+		{
+			char * end;
+			double value = std::strtod(p, &end);
+			if (end == p)
+			{
+				read = false;
+				break;
+			}
+			p = end;
+
+			if (c == xColumn)
+				px = value;
+			if (c == yColumn)
+				py = value;
+		}
+
+		if (!read || !std::isfinite(px) || !std::isfinite(py))
+			continue;
+
+		x.push_back(px);
+		y.push_back(py);
+
+		xMin = std::min(xMin, px);
+		xMax = std::max(xMax, px);
+		yMin = std::min(yMin, py);
+		yMax = std::max(yMax, py);
+	}
+
+	fclose(file);
+
+	width = xMax > xMin || yMax > yMin ? std::max(xMax - xMin, yMax - yMin) : 1;
+
+	return true;
+}
+
+void FindColumns(const char * header, int & xColumn, int & yColumn)
+{
+	xColumn = 0;
+	yColumn = 1;
+
+	int column = 0;
+	bool foundX = false, foundY = false;
+	std::string word;
+
+	for (const char * p = header; ; p++)
+	{
+		if (*p == '\0' || std::isspace((unsigned char) *p))
+		{
+			if (!word.empty())
+			{
+				if (word == "xVec")
+				{
+					xColumn = column;
+					foundX = true;
+				}
+				else if (word == "yVec")
+				{
+					yColumn = column;
+					foundY = true;
+				}
+				column++;
+				word.clear();
+			}
+
+			if (*p == '\0')
+				break;
+		}
+		else
+		{
+			word += *p;
+		}
+	}
+
+	if (!foundX || !foundY)
+	{
+		xColumn = 0;
+		yColumn = 1;
+	}
+}
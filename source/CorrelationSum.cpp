@@ -0,0 +1,233 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the CorrelationSum class.
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include "CorrelationSum.h"
+#include "Parallel.h"
+
+CorrelationSum::CorrelationSum(double rMin, double rMax, int radii) :
+	fSorted(false), fXMin(0), fYMin(0), fCellX(1), fCellY(1), fNX(1), fNY(1), fCentres(0)
+{
+	if (radii < 1)
+		radii = 1;
+
+	double ratio = radii > 1 ? std::pow(rMax / rMin, 1.0 / (radii - 1)) : 1;
+	for (int k = 0; k != radii; k++)
+	{
+		fRadii.push_back(rMin * std::pow(ratio, k));
+		fSquares.push_back(fRadii[k] * fRadii[k]);
+	}
+	//No rounding past the largest radius, which sets the cell size.
+	fRadii[radii - 1] = radii > 1 ? rMax : rMin;
+	fSquares[radii - 1] = fRadii[radii - 1] * fRadii[radii - 1];
+
+	fPairs.assign(radii, 0);
+}
+
+CorrelationSum::~CorrelationSum()
+{}
+
+void CorrelationSum::Add(double x, double y)
+{
+	if (fSorted)
+		return;
+
+	fX.push_back(x);
+	fY.push_back(y);
+}
+
+void CorrelationSum::Sort()
+{
+	fSorted = true;
+
+	long n = fX.size();
+	if (n == 0)
+		return;
+
+	double xMax = fX[0], yMax = fY[0];
+	fXMin = fX[0];
+	fYMin = fY[0];
+	for (long i = 1; i != n; i++)
+	{
+		fXMin = std::min(fXMin, fX[i]);
+		fYMin = std::min(fYMin, fY[i]);
+		xMax = std::max(xMax, fX[i]);
+		yMax = std::max(yMax, fY[i]);
+	}
+
+	//Cells at least as wide as the largest radius, so every pair that
+	//counts is in neighbouring cells, but not many more cells than points.
+	double r = fRadii.back();
+	double nx = std::max(1.0, std::floor((xMax - fXMin) / r));
+	double ny = std::max(1.0, std::floor((yMax - fYMin) / r));
+	double most = 4.0 * n + 16;
+	if (nx * ny > most)
+	{
+		double shrink = std::sqrt(nx * ny / most);
+		nx = std::max(1.0, std::floor(nx / shrink));
+		ny = std::max(1.0, std::floor(ny / shrink));
+	}
+	fNX = (int) nx;
+	fNY = (int) ny;
+	fCellX = std::max((xMax - fXMin) / fNX, r);
+	fCellY = std::max((yMax - fYMin) / fNY, r);
+
+	//Counting sort into cell order.
+	std::vector<int> cell(n);
+	fStart.assign((long) fNX * fNY + 1, 0);
+	for (long i = 0; i != n; i++)
+	{
+		int cx = std::min((int)((fX[i] - fXMin) / fCellX), fNX - 1);
+		int cy = std::min((int)((fY[i] - fYMin) / fCellY), fNY - 1);
+		cell[i] = cy * fNX + cx;
+		fStart[cell[i] + 1]++;
+	}
+	for (unsigned long c = 1; c != fStart.size(); c++)
+		fStart[c] += fStart[c - 1];
+
+	std::vector<long> next(fStart.begin(), fStart.end() - 1);
+	std::vector<double> x(n), y(n);
+	for (long i = 0; i != n; i++)
+	{
+		long j = next[cell[i]]++;
+		x[j] = fX[i];
+		y[j] = fY[i];
+	}
+
+	fX.swap(x);
+	fY.swap(y);
+}
+
+void CorrelationSum::Count(int centres)
+{
+	if (!fSorted)
+		Sort();
+
+	long n = fX.size();
+	int radii = fRadii.size();
+
+	fPairs.assign(radii, 0);
+	fCentres = 0;
+
+	if (n < 2)
+		return;
+
+	if (centres <= 0 || centres > n)
+		centres = n;
+	fCentres = centres;
+
+	double stride = (double) n / centres;
+
+	//With every point a centre each pair need only be counted once, from
+	//the point that comes first in the sorted order: the rest of its own
+	//row of cells, and the row after.
+	bool everyPoint = centres == n;
+	long long weight = everyPoint ? 2 : 1;
+
+	std::vector<std::vector<long long> > histograms(ThreadCount(), std::vector<long long>(radii, 0));
+
+	ParallelFor(centres, [&](int begin, int end, int thread)
+	{
+		std::vector<long long> & histogram = histograms[thread];
+		const double * x = &fX[0];
+		const double * y = &fY[0];
+		const double * squares = &fSquares[0];
+		double largest = squares[radii - 1];
+
+		for (int c = begin; c != end; c++)
+		{
+			long i = (long)(c * stride);
+			double px = x[i], py = y[i];
+
+			int cx = std::min((int)((px - fXMin) / fCellX), fNX - 1);
+			int cy = std::min((int)((py - fYMin) / fCellY), fNY - 1);
+
+			for (int gy = std::max(cy - (everyPoint ? 0 : 1), 0); gy <= std::min(cy + 1, fNY - 1); gy++)
+			{
+				//The cells of a row are next to each other in memory.
+				long first = fStart[(long) gy * fNX + std::max(cx - 1, 0)];
+				long last = fStart[(long) gy * fNX + std::min(cx + 1, fNX - 1) + 1];
+
+				if (everyPoint)
+					first = std::max(first, i + 1);
+
+				for (long j = first; j < last; j++)
+				{
+					double dx = x[j] - px, dy = y[j] - py;
+					double d2 = dx * dx + dy * dy;
+
+					if (d2 < largest && j != i)
+					{
+						//First radius the pair is closer than. Most pairs
+						//are near the largest, so search down from there.
+						int k = radii - 1;
+						while (k > 0 && d2 < squares[k - 1])
+							k--;
+						histogram[k] += weight;
+					}
+				}
+			}
+		}
+	});
+
+	//Pairs closer than each radius.
+	for (unsigned int t = 0; t != histograms.size(); t++)
+	{
+		long long running = 0;
+		for (int k = 0; k != radii; k++)
+		{
+			running += histograms[t][k];
+			fPairs[k] += running;
+		}
+	}
+}
+
+double CorrelationSum::Sum(int k) const
+{
+	if (fCentres == 0)
+		return 0;
+
+	return (double) fPairs[k] / ((double) fCentres * (fX.size() - 1));
+}
+
+double CorrelationSum::Slope(int k) const
+{
+	int a = std::max(k - 1, 0);
+	int b = std::min(k + 1, (int) fRadii.size() - 1);
+
+	if (a == b || fPairs[a] == 0 || fPairs[b] == 0)
+		return 0;
+
+	return std::log((double) fPairs[b] / fPairs[a]) / std::log(fRadii[b] / fRadii[a]);
+}
+
+double CorrelationSum::Dimension(int minK, int maxK) const
+{
+	double sx = 0, sy = 0, sxx = 0, sxy = 0;
+	int points = 0;
+
+	for (int k = std::max(minK, 0); k <= maxK && k < (int) fRadii.size(); k++)
+	{
+		if (fPairs[k] == 0)
+			continue;
+
+		double x = std::log(fRadii[k]);
+		double y = std::log(Sum(k));
+
+		sx += x;
+		sy += y;
+		sxx += x * x;
+		sxy += x * y;
+		points++;
+	}
+
+	if (points < 2)
+		return 0;
+
+	return (points * sxy - sx * sy) / (points * sxx - sx * sx);
+}
@@ -0,0 +1,117 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the CorrelationSum class.
+ */
+
+#ifndef _CORRELATIONSUM_H
+#define _CORRELATIONSUM_H
+
+#include <vector>
+
+/**
+ * Grassberger-Procaccia correlation sum of a set of points: C(r) is the
+ * fraction of pairs of points closer than r, and for a fractal set it goes
+ * as r^D for the correlation dimension D. Unlike box counting this weights
+ * each part of the set by how many points are in it, so it isn't thrown off
+ * by the few sparse boxes at the edges of a cloud like the InnerFrac points.
+ *
+ * The points are sorted into a uniform grid of cells no smaller than the
+ * largest radius, so only the pairs in neighbouring cells are ever looked
+ * at. Pairs are counted from a set of centres (every point, or an even
+ * sample of them) against every point, in parallel, each thread into its
+ * own histogram over the radii.
+ */
+class CorrelationSum
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * double rMin, rMax: smallest and largest radius.
+	 * int radii: number of radii, spaced evenly in log r.
+	 */
+	CorrelationSum(double rMin, double rMax, int radii);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~CorrelationSum();
+
+	/**
+	 * Adds a point.
+	 */
+	void Add(double x, double y);
+
+	/**
+	 * Counts the pairs closer than each radius. The points are sorted into
+	 * the grid the first time, after which no more can be added.
+	 *
+	 * int centres: number of points to count pairs from, 0 or more than
+	 * there are for every point. A sample is taken evenly along the sorted
+	 * points, so it follows the density of the set.
+	 */
+	void Count(int centres);
+
+	/**
+	 * C(r) at one radius, the fraction of pairs from the centres closer
+	 * than r.
+	 *
+	 * int k: index of the radius, 0 to GetRadii() - 1.
+	 */
+	double Sum(int k) const;
+
+	/**
+	 * Local slope d ln C / d ln r at one radius, from its neighbours.
+	 *
+	 * int k: index of the radius.
+	 * return: slope, or 0 where C is 0.
+	 */
+	double Slope(int k) const;
+
+	/**
+	 * Least squares slope of ln C(r) against ln r, over a range of radii.
+	 * Radii with no pairs are skipped.
+	 *
+	 * int minK: first radius to fit.
+	 * int maxK: last radius to fit.
+	 * return: correlation dimension estimate.
+	 */
+	double Dimension(int minK, int maxK) const;
+
+	// Getters.
+	int GetRadii() const { return fRadii.size(); }
+	double GetRadius(int k) const { return fRadii[k]; }
+	long long GetPairs(int k) const { return fPairs[k]; }
+	long GetPoints() const { return fX.size(); }
+	long GetCentres() const { return fCentres; }
+	long GetCells() const { return (long) fNX * fNY; }
+
+private:
+	/**
+	 * Sorts the points into the grid, in cell order.
+	 */
+	void Sort();
+
+	std::vector<double> fRadii;
+	// Squares of the radii, to compare with squared distances.
+	std::vector<double> fSquares;
+
+	std::vector<double> fX;
+	std::vector<double> fY;
+
+	// Grid, and the first point of each cell (and one past the last).
+	bool fSorted;
+	double fXMin;
+	double fYMin;
+	double fCellX;
+	double fCellY;
+	int fNX;
+	int fNY;
+	std::vector<long> fStart;
+
+	// Pairs closer than each radius, and the centres they were counted from.
+	std::vector<long long> fPairs;
+	long fCentres;
+};
+
+#endif
@@ -0,0 +1,74 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the CycleDetector class.
+ */
+
+#include <cmath>
+
+#include "CycleDetector.h"
+#include "Hash.h"
+
+CycleDetector::CycleDetector() :
+	CycleDetector(1e-9, 1e-9)
+{}
+
+CycleDetector::CycleDetector(double sCell, double pCell, int bits, int confirmations) :
+	fSCell(sCell), fPCell(pCell), fConfirmations(confirmations > 0 ? confirmations : 1),
+	fKeys((size_t) 1 << bits, 0), fSeen((size_t) 1 << bits, -1), fMask(((uint64_t) 1 << bits) - 1)
+{
+	Clear();
+}
+
+CycleDetector::~CycleDetector()
+{}
+
+bool CycleDetector::Add(long bounce, double s, double p)
+{
+	if (fPeriodic)
+		return true;
+
+	//Cell indices, packed into one key. p is shifted to be positive.
+	uint64_t i = (uint64_t)(int64_t) std::floor(s / fSCell);
+	uint64_t j = (uint64_t)(int64_t) std::floor((p + 1) / fPCell);
+	uint64_t key = (i << 32) ^ j;
+
+	uint64_t slot = Hash(key) & fMask;
+
+	//A different key in the slot is simply overwritten.
+	long period = (fSeen[slot] >= 0 && fKeys[slot] == key) ? bounce - fSeen[slot] : 0;
+
+	fKeys[slot] = key;
+	fSeen[slot] = bounce;
+
+	if (period > 0 && period == fCandidate)
+	{
+		fMatched++;
+	}
+	else
+	{
+		fCandidate = period;
+		fMatched = period > 0 ? 1 : 0;
+	}
+
+	if (fCandidate > 0 && fMatched >= fConfirmations * fCandidate)
+	{
+		fPeriodic = true;
+		fConfirmed = bounce;
+		fStart = bounce - fMatched - fCandidate + 1;
+	}
+
+	return fPeriodic;
+}
+
+void CycleDetector::Clear()
+{
+	for (unsigned int k = 0; k != fSeen.size(); k++)
+		fSeen[k] = -1;
+
+	fCandidate = 0;
+	fMatched = 0;
+	fPeriodic = false;
+	fStart = 0;
+	fConfirmed = 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the CycleDetector class.
+ */
+
+#ifndef _CYCLEDETECTOR_H
+#define _CYCLEDETECTOR_H
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * Spots a trajectory which has settled into a periodic (or nearly periodic)
+ * orbit, so a long run can stop instead of repeating the same few bounces.
+ *
+ * Each bounce is given as Birkhoff coordinates (s, p), which are rounded
+ * down onto a grid of cells and remembered in a fixed size hash table with
+ * the bounce they were last seen at. When a cell comes round again after P
+ * bounces, P is a candidate period; it is confirmed once every bounce over
+ * several whole periods in a row has come back after exactly P bounces.
+ *
+ * The table is bounded, so old cells are overwritten by new ones and
+ * periods longer than the table can't be found. Orbits which only come back
+ * to within a cell (e.g. quasi-periodic orbits of the circle) count as
+ * periodic if the cells are large enough.
+ */
+class CycleDetector
+{
+public:
+	/**
+	 * Empty constructor, cells of 1e-9 and a table of 2^16 entries.
+	 */
+	CycleDetector();
+	/**
+	 * Constructor.
+	 *
+	 * double sCell: width of a cell in s.
+	 * double pCell: height of a cell in p.
+	 * int bits: the table has 2^bits entries.
+	 * int confirmations: whole periods which must repeat to confirm.
+	 */
+	CycleDetector(double sCell, double pCell, int bits = 16, int confirmations = 3);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~CycleDetector();
+
+	// Getters.
+	bool IsPeriodic() const { return fPeriodic; }
+	long GetPeriod() const { return fPeriodic ? fCandidate : 0; }
+	long GetStart() const { return fStart; }
+	long GetConfirmed() const { return fConfirmed; }
+
+	/**
+	 * Adds the next bounce.
+	 *
+	 * long bounce: number of the bounce, increasing by one each call.
+	 * double s: arc length coordinate of the bounce.
+	 * double p: sine of the reflection angle.
+	 * return: true once a cycle is confirmed.
+	 */
+	bool Add(long bounce, double s, double p);
+
+	/**
+	 * Forgets every bounce, to start a new trajectory.
+	 */
+	void Clear();
+
+private:
+	double fSCell;
+	double fPCell;
+	int fConfirmations;
+
+	// Hash table of cell keys and the bounce each was last seen at, -1 if
+	// the entry is empty.
+	std::vector<uint64_t> fKeys;
+	std::vector<long> fSeen;
+	uint64_t fMask;
+
+	// Current candidate period and how many bounces in a row have matched.
+	long fCandidate;
+	long fMatched;
+
+	bool fPeriodic;
+	// First bounce of the confirmed repeats, and the bounce confirming them.
+	long fStart;
+	long fConfirmed;
+};
+
+#endif
@@ -0,0 +1,171 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the DoubleDouble class.
+ */
+
+#ifndef _DOUBLEDOUBLE_H
+#define _DOUBLEDOUBLE_H
+
+#include <cmath>
+
+/**
+ * Floating point number held as the unevaluated sum of two doubles, fHi +
+ * fLo with |fLo| at most half an ulp of fHi. This gives about 106 bits of
+ * mantissa (32 digits) with the range of a double.
+ *
+ * Every operation is built from error-free transformations (TwoSum and
+ * TwoProd), which find the exact rounding error of a double sum or product
+ * using only ordinary double arithmetic. An operation costs 10-20 doubles,
+ * rather than the hundreds of a software quad type. The operations are
+ * scalar, but inline so the compiler can schedule them with the
+ * surrounding code; DoubleDoubleLanes does the same operations on several
+ * numbers at once, in vector registers.
+ *
+ * The operators are those needed by TVector and TableKernel, so the table
+ * kernels can be run in double-double precision as TableKernel<DoubleDouble>.
+ */
+class DoubleDouble
+{
+public:
+	/**
+	 * Empty constructor, zero.
+	 */
+	DoubleDouble() : fHi(0), fLo(0) {}
+	/**
+	 * Constructor from a double, which is held exactly.
+	 */
+	DoubleDouble(double x) : fHi(x), fLo(0) {}
+	/**
+	 * Constructor from the two parts, which must already be normalised.
+	 */
+	DoubleDouble(double hi, double lo) : fHi(hi), fLo(lo) {}
+
+	/**
+	 * Rounds to the nearest double.
+	 */
+	explicit operator double() const { return fHi; }
+
+	// Getters.
+	double GetHi() const { return fHi; }
+	double GetLo() const { return fLo; }
+
+	/**
+	 * Exact sum of two doubles, s + e = a + b (Knuth).
+	 */
+	static DoubleDouble TwoSum(double a, double b)
+	{
+		double s = a + b;
+		double v = s - a;
+		double e = (a - (s - v)) + (b - v);
+		return DoubleDouble(s, e);
+	}
+
+	/**
+	 * Exact sum of two doubles with |a| >= |b| (Dekker), cheaper than TwoSum.
+	 */
+	static DoubleDouble QuickTwoSum(double a, double b)
+	{
+		double s = a + b;
+		return DoubleDouble(s, b - (s - a));
+	}
+
+	/**
+	 * Exact product of two doubles, p + e = a * b. Uses a fused multiply
+	 * add where the hardware has one, and Dekker's splitting otherwise.
+	 */
+	static DoubleDouble TwoProd(double a, double b)
+	{
+		double p = a * b;
+#ifdef FP_FAST_FMA
+		return DoubleDouble(p, std::fma(a, b, -p));
+#else
+		double aHi, aLo, bHi, bLo;
+		Split(a, aHi, aLo);
+		Split(b, bHi, bLo);
+		return DoubleDouble(p, ((aHi * bHi - p) + aHi * bLo + aLo * bHi) + aLo * bLo);
+#endif
+	}
+
+	// Arithmetic.
+	DoubleDouble operator-() const { return DoubleDouble(-fHi, -fLo); }
+
+	DoubleDouble operator+(const DoubleDouble & other) const
+	{
+		DoubleDouble s = TwoSum(fHi, other.fHi);
+		DoubleDouble t = TwoSum(fLo, other.fLo);
+		s = QuickTwoSum(s.fHi, s.fLo + t.fHi);
+		return QuickTwoSum(s.fHi, s.fLo + t.fLo);
+	}
+
+	DoubleDouble operator-(const DoubleDouble & other) const { return *this + (-other); }
+
+	DoubleDouble operator*(const DoubleDouble & other) const
+	{
+		DoubleDouble p = TwoProd(fHi, other.fHi);
+		return QuickTwoSum(p.fHi, p.fLo + (fHi * other.fLo + fLo * other.fHi));
+	}
+
+	DoubleDouble operator/(const DoubleDouble & other) const
+	{
+		//Long division: first quotient, then correct with the remainder.
+		double q1 = fHi / other.fHi;
+		DoubleDouble r = *this - other * DoubleDouble(q1);
+		double q2 = r.fHi / other.fHi;
+		r = r - other * DoubleDouble(q2);
+		double q3 = r.fHi / other.fHi;
+
+		DoubleDouble q = QuickTwoSum(q1, q2);
+		return q + DoubleDouble(q3);
+	}
+
+	DoubleDouble & operator+=(const DoubleDouble & other) { return *this = *this + other; }
+	DoubleDouble & operator-=(const DoubleDouble & other) { return *this = *this - other; }
+	DoubleDouble & operator*=(const DoubleDouble & other) { return *this = *this * other; }
+	DoubleDouble & operator/=(const DoubleDouble & other) { return *this = *this / other; }
+
+	// Comparisons.
+	bool operator==(const DoubleDouble & other) const { return fHi == other.fHi && fLo == other.fLo; }
+	bool operator!=(const DoubleDouble & other) const { return !(*this == other); }
+	bool operator<(const DoubleDouble & other) const { return fHi < other.fHi || (fHi == other.fHi && fLo < other.fLo); }
+	bool operator>(const DoubleDouble & other) const { return other < *this; }
+	bool operator<=(const DoubleDouble & other) const { return fHi < other.fHi || (fHi == other.fHi && fLo <= other.fLo); }
+	bool operator>=(const DoubleDouble & other) const { return other <= *this; }
+
+private:
+	/**
+	 * Splits a into two halves of 26 bits each, a = hi + lo.
+	 */
+	static void Split(double a, double & hi, double & lo)
+	{
+		double t = 134217729.0 * a;
+		hi = t - (t - a);
+		lo = a - hi;
+	}
+
+	double fHi;
+	double fLo;
+};
+
+/**
+ * Square root, by one Newton step from the double square root.
+ */
+inline DoubleDouble sqrt(const DoubleDouble & x)
+{
+	if (x.GetHi() <= 0)
+		return DoubleDouble(0);
+
+	double r = std::sqrt(x.GetHi());
+	DoubleDouble s = DoubleDouble::TwoProd(r, r);
+	return DoubleDouble::QuickTwoSum(r, (x - s).GetHi() / (2 * r));
+}
+
+/**
+ * Absolute value.
+ */
+inline DoubleDouble abs(const DoubleDouble & x)
+{
+	return x.GetHi() < 0 ? -x : x;
+}
+
+#endif
@@ -0,0 +1,314 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the DoubleDoubleLanes and LaneMask class templates.
+ */
+
+#ifndef _DOUBLEDOUBLELANES_H
+#define _DOUBLEDOUBLELANES_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "DoubleDouble.h"
+
+/**
+ * Result of comparing N lanes, one flag per lane. Each flag is a 64 bit
+ * integer, all ones for on and zero for off, the same width as the doubles
+ * it was made from, so Select can pick between doubles with bitwise
+ * operations and no branches.
+ */
+template <int N>
+class LaneMask
+{
+public:
+	/**
+	 * Empty constructor, no lanes set.
+	 */
+	LaneMask()
+	{
+		for (int i = 0; i < N; i++)
+			fOn[i] = 0;
+	}
+	/**
+	 * Constructor setting every lane to on.
+	 */
+	explicit LaneMask(bool on)
+	{
+		for (int i = 0; i < N; i++)
+			fOn[i] = -int64_t(on);
+	}
+
+	// Getters and setters.
+	bool Get(int lane) const { return fOn[lane] != 0; }
+	void Set(int lane, bool on) { fOn[lane] = -int64_t(on); }
+
+	/**
+	 * True if any lane is on.
+	 */
+	bool Any() const
+	{
+		int64_t any = 0;
+		for (int i = 0; i < N; i++)
+			any |= fOn[i];
+		return any != 0;
+	}
+	/**
+	 * True if every lane is on.
+	 */
+	bool All() const
+	{
+		int64_t all = -1;
+		for (int i = 0; i < N; i++)
+			all &= fOn[i];
+		return all != 0;
+	}
+
+	// Lane-wise logic.
+	LaneMask operator&(const LaneMask & other) const
+	{
+		LaneMask r;
+		for (int i = 0; i < N; i++)
+			r.fOn[i] = fOn[i] & other.fOn[i];
+		return r;
+	}
+
+	LaneMask operator|(const LaneMask & other) const
+	{
+		LaneMask r;
+		for (int i = 0; i < N; i++)
+			r.fOn[i] = fOn[i] | other.fOn[i];
+		return r;
+	}
+
+	LaneMask operator!() const
+	{
+		LaneMask r;
+		for (int i = 0; i < N; i++)
+			r.fOn[i] = ~fOn[i];
+		return r;
+	}
+
+	// Public so DoubleDoubleLanes can fill it from its comparisons.
+	int64_t fOn[N];
+};
+
+/**
+ * N DoubleDouble numbers held as a structure of arrays, N high parts and
+ * then N low parts, for running N independent balls at once. Every
+ * operation is a loop over the lanes doing exactly what the DoubleDouble
+ * operation does, so each lane gives the same bits as DoubleDouble would.
+ * The arithmetic loops have no branches and are vectorised by the compiler
+ * at -O2; the comparisons are still done a lane at a time.
+ *
+ * Comparisons give a LaneMask rather than a bool, and branches become
+ * Select, so TVector<DoubleDoubleLanes<N> > works but TableKernel does not
+ * (see BatchKernel).
+ */
+template <int N>
+class DoubleDoubleLanes
+{
+public:
+	typedef LaneMask<N> Mask;
+
+	/**
+	 * Empty constructor, zero in every lane.
+	 */
+	DoubleDoubleLanes()
+	{
+		for (int i = 0; i < N; i++)
+		{
+			fHi[i] = 0;
+			fLo[i] = 0;
+		}
+	}
+	/**
+	 * Constructor from a double, held exactly in every lane.
+	 */
+	DoubleDoubleLanes(double x)
+	{
+		for (int i = 0; i < N; i++)
+		{
+			fHi[i] = x;
+			fLo[i] = 0;
+		}
+	}
+
+	// Getters and setters.
+	DoubleDouble Get(int lane) const { return DoubleDouble(fHi[lane], fLo[lane]); }
+	void Set(int lane, const DoubleDouble & x)
+	{
+		fHi[lane] = x.GetHi();
+		fLo[lane] = x.GetLo();
+	}
+
+	// Arithmetic, as DoubleDouble.
+	DoubleDoubleLanes operator-() const
+	{
+		DoubleDoubleLanes r;
+		for (int i = 0; i < N; i++)
+		{
+			r.fHi[i] = -fHi[i];
+			r.fLo[i] = -fLo[i];
+		}
+		return r;
+	}
+
+	DoubleDoubleLanes operator+(const DoubleDoubleLanes & other) const
+	{
+		DoubleDoubleLanes r;
+		for (int i = 0; i < N; i++)
+		{
+			double sHi, sLo, tHi, tLo;
+			TwoSum(fHi[i], other.fHi[i], sHi, sLo);
+			TwoSum(fLo[i], other.fLo[i], tHi, tLo);
+			QuickTwoSum(sHi, sLo + tHi, sHi, sLo);
+			QuickTwoSum(sHi, sLo + tLo, r.fHi[i], r.fLo[i]);
+		}
+		return r;
+	}
+
+	DoubleDoubleLanes operator-(const DoubleDoubleLanes & other) const { return *this + (-other); }
+
+	DoubleDoubleLanes operator*(const DoubleDoubleLanes & other) const
+	{
+		DoubleDoubleLanes r;
+		for (int i = 0; i < N; i++)
+		{
+			double pHi, pLo;
+			TwoProd(fHi[i], other.fHi[i], pHi, pLo);
+			QuickTwoSum(pHi, pLo + (fHi[i] * other.fLo[i] + fLo[i] * other.fHi[i]), r.fHi[i], r.fLo[i]);
+		}
+		return r;
+	}
+
+	DoubleDoubleLanes operator/(const DoubleDoubleLanes & other) const
+	{
+		//Long division, as DoubleDouble.
+		DoubleDoubleLanes q1, q2, q3;
+		for (int i = 0; i < N; i++)
+			q1.fHi[i] = fHi[i] / other.fHi[i];
+
+		DoubleDoubleLanes r = *this - other * q1;
+		for (int i = 0; i < N; i++)
+			q2.fHi[i] = r.fHi[i] / other.fHi[i];
+
+		r = r - other * q2;
+		for (int i = 0; i < N; i++)
+		{
+			q3.fHi[i] = r.fHi[i] / other.fHi[i];
+			QuickTwoSum(q1.fHi[i], q2.fHi[i], q1.fHi[i], q1.fLo[i]);
+		}
+
+		return q1 + q3;
+	}
+
+	// Comparisons, as DoubleDouble.
+	Mask operator==(const DoubleDoubleLanes & other) const
+	{
+		Mask r;
+		for (int i = 0; i < N; i++)
+			r.fOn[i] = -int64_t((fHi[i] == other.fHi[i]) & (fLo[i] == other.fLo[i]));
+		return r;
+	}
+	Mask operator!=(const DoubleDoubleLanes & other) const { return !(*this == other); }
+
+	Mask operator<(const DoubleDoubleLanes & other) const
+	{
+		Mask r;
+		for (int i = 0; i < N; i++)
+			r.fOn[i] = -int64_t((fHi[i] < other.fHi[i]) | ((fHi[i] == other.fHi[i]) & (fLo[i] < other.fLo[i])));
+		return r;
+	}
+	Mask operator>(const DoubleDoubleLanes & other) const { return other < *this; }
+
+	Mask operator<=(const DoubleDoubleLanes & other) const
+	{
+		Mask r;
+		for (int i = 0; i < N; i++)
+			r.fOn[i] = -int64_t((fHi[i] < other.fHi[i]) | ((fHi[i] == other.fHi[i]) & (fLo[i] <= other.fLo[i])));
+		return r;
+	}
+	Mask operator>=(const DoubleDoubleLanes & other) const { return other <= *this; }
+
+	/**
+	 * Lane-wise choice, a where mask is on and b elsewhere.
+	 */
+	static DoubleDoubleLanes Select(const Mask & mask, const DoubleDoubleLanes & a, const DoubleDoubleLanes & b)
+	{
+		DoubleDoubleLanes r;
+		Select(mask, a.fHi, b.fHi, r.fHi);
+		Select(mask, a.fLo, b.fLo, r.fLo);
+		return r;
+	}
+
+	/**
+	 * Square root, as sqrt(DoubleDouble).
+	 */
+	friend DoubleDoubleLanes sqrt(const DoubleDoubleLanes & x)
+	{
+		DoubleDoubleLanes r, s;
+		for (int i = 0; i < N; i++)
+		{
+			//Non-positive lanes are worked on 1 and then set to 0, so the
+			//loop never calls sqrt on a negative.
+			double hi = x.fHi[i] > 0 ? x.fHi[i] : 1;
+			r.fHi[i] = std::sqrt(hi);
+			TwoProd(r.fHi[i], r.fHi[i], s.fHi[i], s.fLo[i]);
+		}
+
+		DoubleDoubleLanes d = x - s;
+		for (int i = 0; i < N; i++)
+		{
+			QuickTwoSum(r.fHi[i], d.fHi[i] / (2 * r.fHi[i]), r.fHi[i], r.fLo[i]);
+			r.fHi[i] = x.fHi[i] > 0 ? r.fHi[i] : 0;
+			r.fLo[i] = x.fHi[i] > 0 ? r.fLo[i] : 0;
+		}
+		return r;
+	}
+
+private:
+	/**
+	 * Picks the bits of a or b in each lane by the mask. The doubles are
+	 * copied to integers and back, which the compiler turns into plain
+	 * register moves.
+	 */
+	static void Select(const Mask & mask, const double a[N], const double b[N], double r[N])
+	{
+		int64_t x[N], y[N], z[N];
+		std::memcpy(x, a, sizeof(x));
+		std::memcpy(y, b, sizeof(y));
+		for (int i = 0; i < N; i++)
+			z[i] = (x[i] & mask.fOn[i]) | (y[i] & ~mask.fOn[i]);
+		std::memcpy(r, z, sizeof(z));
+	}
+
+	// Error-free transformations on one lane, as DoubleDouble.
+	static void TwoSum(double a, double b, double & s, double & e)
+	{
+		double sum = a + b;
+		double v = sum - a;
+		e = (a - (sum - v)) + (b - v);
+		s = sum;
+	}
+
+	static void QuickTwoSum(double a, double b, double & s, double & e)
+	{
+		double sum = a + b;
+		e = b - (sum - a);
+		s = sum;
+	}
+
+	static void TwoProd(double a, double b, double & p, double & e)
+	{
+		DoubleDouble r = DoubleDouble::TwoProd(a, b);
+		p = r.GetHi();
+		e = r.GetLo();
+	}
+
+	double fHi[N];
+	double fLo[N];
+};
+
+#endif
@@ -0,0 +1,51 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the DriftMonitor class.
+ */
+
+#include "DriftMonitor.h"
+
+DriftMonitor::DriftMonitor() :
+	fSpeedTolerance(1e-3), fEdgeTolerance(1e-3), fChecks(0), fLost(0), fMaxSpeed(0), fMaxEdge(0), fSpeedSum(0),
+	fEdgeSum(0)
+{}
+
+DriftMonitor::DriftMonitor(double speedTolerance, double edgeTolerance) :
+	fSpeedTolerance(speedTolerance), fEdgeTolerance(edgeTolerance), fChecks(0), fLost(0), fMaxSpeed(0), fMaxEdge(0),
+	fSpeedSum(0), fEdgeSum(0)
+{}
+
+DriftMonitor::~DriftMonitor()
+{}
+
+void DriftMonitor::Merge(const DriftMonitor & other)
+{
+	if (other.fMaxSpeed > fMaxSpeed)
+		fMaxSpeed = other.fMaxSpeed;
+	if (other.fMaxEdge > fMaxEdge)
+		fMaxEdge = other.fMaxEdge;
+
+	fSpeedSum += other.fSpeedSum;
+	fEdgeSum += other.fEdgeSum;
+	fChecks += other.fChecks;
+	fLost += other.fLost;
+}
+
+bool DriftMonitor::Degraded() const
+{
+	return fLost > 0 || fMaxSpeed > fSpeedTolerance || fMaxEdge > fEdgeTolerance;
+}
+
+void DriftMonitor::Write(FILE * file) const
+{
+	fprintf(file, "Speed drift: max %.3g, mean %.3g (tolerance %.3g)\n", fMaxSpeed, GetMeanSpeed(), fSpeedTolerance);
+	fprintf(file, "Distance from edge: max %.3g, mean %.3g (tolerance %.3g)\n", fMaxEdge, GetMeanEdge(),
+		fEdgeTolerance);
+
+	if (fLost > 0)
+		fprintf(file, "%li balls lost the table and were stopped.\n", fLost);
+
+	if (Degraded())
+		fprintf(file, "WARNING: reduced precision has degraded this run, rerun in double precision.\n");
+}
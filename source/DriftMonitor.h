@@ -0,0 +1,104 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the DriftMonitor class.
+ */
+
+#ifndef _DRIFTMONITOR_H
+#define _DRIFTMONITOR_H
+
+#include <cstdio>
+
+/**
+ * Keeps track of how far a run in reduced precision has drifted from the
+ * exact billiard: the relative change of each ball's speed, which should be
+ * constant, and how far the collision points lie off the table edge. Balls
+ * which lose the table altogether are counted as lost.
+ *
+ * Each thread of an ensemble run fills its own copy, which are merged at the
+ * end, as for EscapeStatistics.
+ */
+class DriftMonitor
+{
+public:
+	/**
+	 * Constructor with default tolerances of 1e-3.
+	 */
+	DriftMonitor();
+	/**
+	 * Constructor giving the largest drifts which are still acceptable.
+	 *
+	 * double speedTolerance: largest relative change in speed.
+	 * double edgeTolerance: largest distance of a collision from the edge.
+	 */
+	DriftMonitor(double speedTolerance, double edgeTolerance);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~DriftMonitor();
+
+	// Getters.
+	long GetChecks() const { return fChecks; }
+	long GetLost() const { return fLost; }
+	double GetMaxSpeed() const { return fMaxSpeed; }
+	double GetMaxEdge() const { return fMaxEdge; }
+	double GetMeanSpeed() const { return fChecks ? fSpeedSum / fChecks : 0; }
+	double GetMeanEdge() const { return fChecks ? fEdgeSum / fChecks : 0; }
+
+	/**
+	 * Records the state of one ball after a collision.
+	 *
+	 * double speed: relative change in speed since the start, |v|/|v0| - 1.
+	 * double edge: signed distance of the collision point outside the edge.
+	 */
+	void Check(double speed, double edge)
+	{
+		speed = speed < 0 ? -speed : speed;
+		edge = edge < 0 ? -edge : edge;
+
+		if (speed > fMaxSpeed)
+			fMaxSpeed = speed;
+		if (edge > fMaxEdge)
+			fMaxEdge = edge;
+
+		fSpeedSum += speed;
+		fEdgeSum += edge;
+		fChecks++;
+	}
+
+	/**
+	 * Records a ball which has lost the table (no collision could be found).
+	 */
+	void Lose() { fLost++; }
+
+	/**
+	 * Adds the records from other. The tolerances of this are kept.
+	 */
+	void Merge(const DriftMonitor & other);
+
+	/**
+	 * Whether the run has drifted past either tolerance, or lost any balls.
+	 *
+	 * return: true if the reduced precision can't be trusted for this run.
+	 */
+	bool Degraded() const;
+
+	/**
+	 * Prints the largest and mean drifts, and a warning if Degraded().
+	 *
+	 * FILE * file: stream to print to, e.g. stdout.
+	 */
+	void Write(FILE * file) const;
+
+private:
+	double fSpeedTolerance;
+	double fEdgeTolerance;
+	long fChecks;
+	long fLost;
+	double fMaxSpeed;
+	double fMaxEdge;
+	double fSpeedSum;
+	double fEdgeSum;
+};
+
+#endif
@@ -5,6 +5,7 @@
  */
 
 #include <cmath>
+#include <algorithm>
 
 #include "EllipseTable.h"
 
@@ -13,7 +14,9 @@ EllipseTable::EllipseTable()
 
 EllipseTable::EllipseTable(double radius, double xCoef, double yCoef) :
 	fRadius(radius), fXCoef(xCoef), fYCoef(yCoef)
-{}
+{
+	UpdateArc();
+}
 
 EllipseTable::~EllipseTable()
 {}
@@ -59,3 +62,81 @@ Vector EllipseTable::CollisionPoint(const Vector & initial, const Vector & veloc
 	return initial + gamma * velocity;
 
 }
+
+double EllipseTable::BoundaryPosition(const Vector & collision)
+{
+	//Parametric angle t, where x = r*a*cos(t) and y = r*b*sin(t).
+	double t = std::atan2(collision.fY / fYCoef, collision.fX / fXCoef);
+	if (t < 0)
+		t += 2*M_PI;
+
+	//Interpolate in the arc length table.
+	double step = 2*M_PI / kArcSegments;
+	int i = (int)(t / step);
+	if (i >= kArcSegments)
+		i = kArcSegments - 1;
+
+	return fArc[i] + (fArc[i+1] - fArc[i]) * (t - i*step) / step;
+}
+
+double EllipseTable::BoundaryLength()
+{
+	return fArc[kArcSegments];
+}
+
+Vector EllipseTable::BoundaryPoint(double s)
+{
+	//Find the segment of the arc length table containing s, and
+	//interpolate the parametric angle t within it.
+	int i = std::upper_bound(fArc.begin(), fArc.end(), s) - fArc.begin() - 1;
+	if (i < 0)
+		i = 0;
+	if (i >= kArcSegments)
+		i = kArcSegments - 1;
+
+	double step = 2*M_PI / kArcSegments;
+	double t = step * (i + (s - fArc[i]) / (fArc[i+1] - fArc[i]));
+
+	return Vector(fRadius * fXCoef * std::cos(t), fRadius * fYCoef * std::sin(t));
+}
+
+void EllipseTable::UpdateArc()
+{
+	double a = fRadius * fXCoef;
+	double b = fRadius * fYCoef;
+	double step = 2*M_PI / kArcSegments;
+
+	fArc.resize(kArcSegments + 1);
+	fArc[0] = 0;
+
+	//Simpson's rule on ds/dt over each segment.
+	for (int i = 0; i != kArcSegments; i++)
+	{
+		double t0 = i * step, t1 = t0 + step/2, t2 = t0 + step;
+		double d0 = std::sqrt(a*a*std::sin(t0)*std::sin(t0) + b*b*std::cos(t0)*std::cos(t0));
+		double d1 = std::sqrt(a*a*std::sin(t1)*std::sin(t1) + b*b*std::cos(t1)*std::cos(t1));
+		double d2 = std::sqrt(a*a*std::sin(t2)*std::sin(t2) + b*b*std::cos(t2)*std::cos(t2));
+
+		fArc[i+1] = fArc[i] + step * (d0 + 4*d1 + d2) / 6;
+	}
+}
+
+Vector EllipseTable::Normal(const Vector & collision)
+{
+	//Gradient of x^2 + (a/b)^2 y^2, reversed to point inwards.
+	Vector norm(-collision.fX * fYCoef * fYCoef, -collision.fY * fXCoef * fXCoef);
+
+	return norm / norm.Mod();
+}
+
+double EllipseTable::Curvature(const Vector & collision)
+{
+	//Semi-axes a and b. With collision = (a cos t, b sin t) the curvature
+	//is ab / (a^2 sin^2 t + b^2 cos^2 t)^(3/2).
+	double a = fRadius * fXCoef;
+	double b = fRadius * fYCoef;
+	double sinT = collision.fY / b;
+	double cosT = collision.fX / a;
+
+	return a * b / std::pow(a * a * sinT * sinT + b * b * cosT * cosT, 1.5);
+}
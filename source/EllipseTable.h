@@ -7,6 +7,8 @@
 #ifndef _ELLIPSETABLE_H
 #define _ELLIPSETABLE_H
 
+#include <vector>
+
 #include "ITable.h"
 
 /**
@@ -32,20 +34,40 @@ public:
 	double GetRadius() const { return fRadius; }
 	double GetXCoef()const { return fXCoef; }
 	double GetYCoef() const { return fYCoef; }
-	void SetRadius(double radius) { if (radius > 0) fRadius = radius; }
-	void SetXCoef(double xCoef) {if (xCoef > 0) fXCoef = xCoef; }
-	void SetYCoef(double yCoef) {if (yCoef > 0) fYCoef = yCoef; }
+	void SetRadius(double radius) { if (radius > 0) fRadius = radius; UpdateArc(); }
+	void SetXCoef(double xCoef) {if (xCoef > 0) fXCoef = xCoef; UpdateArc(); }
+	void SetYCoef(double yCoef) {if (yCoef > 0) fYCoef = yCoef; UpdateArc(); }
 
 	// Implemented from ITable.
 	double AngleIncidence(const Vector & collision, const Vector & velocity);
 	Vector ReflectVector(const Vector & collision, const Vector & velocity);
 	Vector CollisionPoint(const Vector & initial, const Vector & velocity);
+	// Boundary coordinate starts at (r*xCoef,0) and runs anticlockwise.
+	double BoundaryPosition(const Vector & collision);
+	double BoundaryLength();
+	Vector BoundaryPoint(double s);
+	Vector Normal(const Vector & collision);
+	int Component(const Vector & collision) { return 0; }
+	int ComponentCount() { return 1; }
+	double Curvature(const Vector & collision);
 
 private:
+	/**
+	 * There is no closed form for the arc length of an ellipse, so it is
+	 * tabulated against the parametric angle whenever the geometry changes.
+	 */
+	void UpdateArc();
+
+	// Number of segments in the arc length table.
+	static const int kArcSegments = 1024;
+
 	// Ellipse parameters.
 	double fRadius;
 	double fXCoef;
 	double fYCoef;
+
+	// Arc length at parametric angles 2pi*i/kArcSegments.
+	std::vector<double> fArc;
 };
 
 #endif
@@ -0,0 +1,239 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the Ensemble class.
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include "Ensemble.h"
+#include "Parallel.h"
+
+Ensemble::Ensemble() :
+	fActive(0)
+{}
+
+Ensemble::Ensemble(int size) :
+	fActive(0)
+{
+	fPX.reserve(size);
+	fPY.reserve(size);
+	fVX.reserve(size);
+	fVY.reserve(size);
+	fBounces.reserve(size);
+	fTime.reserve(size);
+}
+
+Ensemble::~Ensemble()
+{}
+
+void Ensemble::Add(const Vector & position, const Vector & velocity)
+{
+	//Keep new balls in the active range by swapping out the first
+	//finished one, if there are any.
+	fPX.push_back(position.fX);
+	fPY.push_back(position.fY);
+	fVX.push_back(velocity.fX);
+	fVY.push_back(velocity.fY);
+	fBounces.push_back(0);
+	fTime.push_back(0);
+
+	int last = fPX.size() - 1;
+	if (last != fActive)
+	{
+		std::swap(fPX[last], fPX[fActive]);
+		std::swap(fPY[last], fPY[fActive]);
+		std::swap(fVX[last], fVX[fActive]);
+		std::swap(fVY[last], fVY[fActive]);
+		std::swap(fBounces[last], fBounces[fActive]);
+		std::swap(fTime[last], fTime[fActive]);
+	}
+	fActive++;
+}
+
+void Ensemble::Escape(OpenTable & table, int maxBounces, EscapeStatistics & statistics)
+{
+	//Bounces per batch between compactions.
+	const int batch = 64;
+
+	//Each thread gets its own histograms.
+	std::vector<EscapeStatistics> local(ThreadCount(),
+		EscapeStatistics(statistics.GetMaxBounces(), statistics.GetTimeBin()));
+
+	std::vector<char> escaped;
+
+	for (int done = 0; done < maxBounces && fActive > 0; done += batch)
+	{
+		int steps = std::min(batch, maxBounces - done);
+		escaped.assign(fActive, 0);
+
+		ParallelFor(fActive, [&](int begin, int end, int thread)
+		{
+			for (int i = begin; i != end; i++)
+			{
+				Vector position(fPX[i], fPY[i]);
+				Vector velocity(fVX[i], fVY[i]);
+				Vector collision;
+				double speed = velocity.Mod();
+
+				for (int j = 0; j != steps; j++)
+				{
+					collision = table.CollisionPoint(position, velocity);
+					fTime[i] += (collision - position).Mod() / speed;
+					fBounces[i]++;
+
+					if (table.Escapes(collision))
+					{
+						local[thread].Record(fBounces[i], fTime[i]);
+						escaped[i] = 1;
+						position = collision;
+						break;
+					}
+
+					velocity = table.ReflectVector(collision, velocity);
+					position = collision;
+				}
+
+				fPX[i] = position.fX;
+				fPY[i] = position.fY;
+				fVX[i] = velocity.fX;
+				fVY[i] = velocity.fY;
+			}
+		});
+
+		Compact(escaped);
+	}
+
+	//Reduce thread histograms.
+	for (unsigned int t = 0; t != local.size(); t++)
+		statistics.Merge(local[t]);
+
+	statistics.Censor(fActive);
+}
+
+void Ensemble::Run(ITable & table, int bounces,
+	const std::function<void(int ball, int bounce, const Vector & position, const Vector & velocity, int thread)> & observe)
+{
+	ParallelFor(fActive, [&](int begin, int end, int thread)
+	{
+		for (int i = begin; i != end; i++)
+		{
+			Vector position(fPX[i], fPY[i]);
+			Vector velocity(fVX[i], fVY[i]);
+			Vector collision;
+			double speed = velocity.Mod();
+
+			for (int j = 0; j != bounces; j++)
+			{
+				collision = table.CollisionPoint(position, velocity);
+				fTime[i] += (collision - position).Mod() / speed;
+				velocity = table.ReflectVector(collision, velocity);
+				position = collision;
+
+				observe(i, j, position, velocity, thread);
+			}
+
+			fBounces[i] += bounces;
+			fPX[i] = position.fX;
+			fPY[i] = position.fY;
+			fVX[i] = velocity.fX;
+			fVY[i] = velocity.fY;
+		}
+	});
+}
+
+int Ensemble::Advance(ITable & table, double dt,
+	const std::function<void(int ball, const Vector & position, const Vector & velocity, int thread)> & observe,
+	std::vector<char> & lost, int maxBounces)
+{
+	lost.assign(fActive, 0);
+	std::vector<int> count(ThreadCount(), 0);
+
+	ParallelFor(fActive, [&](int begin, int end, int thread)
+	{
+		for (int i = begin; i != end; i++)
+		{
+			Vector position(fPX[i], fPY[i]);
+			Vector velocity(fVX[i], fVY[i]);
+			double speed = velocity.Mod();
+			double remaining = dt;
+			int bounces = 0, still = 0;
+
+			//Whole flights while they fit in the step, then part of one.
+			while (true)
+			{
+				Vector collision = table.CollisionPoint(position, velocity);
+				double flight = (collision - position).Mod() / speed;
+
+				//A ball can stop a step right on the wall, or bounce into a
+				//corner, so a few flights of length 0 in a row are fine; more
+				//means it is stuck.
+				still = flight > 0 ? 0 : still + 1;
+
+				if (!(flight >= 0) || !std::isfinite(flight) || still > 4 || bounces == maxBounces)
+				{
+					lost[i] = 1;
+					break;
+				}
+
+				if (flight > remaining)
+				{
+					position = position + velocity * remaining;
+					break;
+				}
+
+				remaining -= flight;
+				velocity = table.ReflectVector(collision, velocity);
+				position = collision;
+				bounces++;
+			}
+
+			if (lost[i])
+			{
+				count[thread]++;
+				continue;
+			}
+
+			fBounces[i] += bounces;
+			fTime[i] += dt;
+			fPX[i] = position.fX;
+			fPY[i] = position.fY;
+			fVX[i] = velocity.fX;
+			fVY[i] = velocity.fY;
+
+			observe(i, position, velocity, thread);
+		}
+	});
+
+	int total = 0;
+	for (unsigned int t = 0; t != count.size(); t++)
+		total += count[t];
+
+	return total;
+}
+
+void Ensemble::Compact(const std::vector<char> & finished)
+{
+	int live = 0;
+
+	//Stable partition, survivors keep their relative order.
+	for (int i = 0; i != fActive; i++)
+	{
+		if (finished[i])
+			continue;
+
+		if (i != live)
+		{
+			std::swap(fPX[i], fPX[live]);
+			std::swap(fPY[i], fPY[live]);
+			std::swap(fVX[i], fVX[live]);
+			std::swap(fVY[i], fVY[live]);
+			std::swap(fBounces[i], fBounces[live]);
+			std::swap(fTime[i], fTime[live]);
+		}
+		live++;
+	}
+
+	fActive = live;
+}
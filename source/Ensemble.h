@@ -0,0 +1,132 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the Ensemble class.
+ */
+
+#ifndef _ENSEMBLE_H
+#define _ENSEMBLE_H
+
+#include <vector>
+#include <functional>
+
+#include "Vector.h"
+#include "OpenTable.h"
+#include "EscapeStatistics.h"
+
+/**
+ * A batch of independent billiard balls, stored as structure-of-arrays so
+ * that each thread streams through contiguous memory. The balls in
+ * [0, GetActive()) are still being simulated; balls which are finished with
+ * (e.g. have escaped) are compacted out of that range so later batches only
+ * touch live balls.
+ */
+class Ensemble
+{
+public:
+	/**
+	 * Empty constructor, no balls.
+	 */
+	Ensemble();
+	/**
+	 * Constructor reserving memory for size balls.
+	 */
+	Ensemble(int size);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~Ensemble();
+
+	/**
+	 * Adds a ball to the active set.
+	 *
+	 * Vector & position: initial position of the ball.
+	 * Vector & velocity: initial velocity of the ball.
+	 */
+	void Add(const Vector & position, const Vector & velocity);
+
+	// Getters.
+	int GetSize() const { return fPX.size(); }
+	int GetActive() const { return fActive; }
+	Vector GetPosition(int i) const { return Vector(fPX[i], fPY[i]); }
+	Vector GetVelocity(int i) const { return Vector(fVX[i], fVY[i]); }
+	int GetBounces(int i) const { return fBounces[i]; }
+	double GetTime(int i) const { return fTime[i]; }
+
+	/**
+	 * Runs every active ball on an open table until it escapes, or until it
+	 * has made maxBounces collisions. Escapes are recorded into statistics
+	 * and balls still on the table at the end are recorded as censored.
+	 *
+	 * The balls are advanced in parallel in batches of bounces, with each
+	 * thread filling its own copy of the statistics. Escaped balls are
+	 * compacted out after every batch.
+	 *
+	 * OpenTable & table: open table to run on.
+	 * int maxBounces: maximum collisions for any ball.
+	 * EscapeStatistics & statistics: histograms to add the results to.
+	 */
+	void Escape(OpenTable & table, int maxBounces, EscapeStatistics & statistics);
+
+	/**
+	 * Runs every active ball on for a number of bounces, in parallel. After
+	 * each bounce observe(ball, bounce, position, velocity, thread) is called
+	 * with the collision point and the velocity leaving it. bounce counts
+	 * from 0 within this call, and thread is as for ParallelFor so results
+	 * can be kept per thread.
+	 *
+	 * ITable & table: table to run on.
+	 * int bounces: number of bounces for every ball.
+	 * observe: function called after every bounce of every ball.
+	 */
+	void Run(ITable & table, int bounces,
+		const std::function<void(int ball, int bounce, const Vector & position, const Vector & velocity, int thread)> & observe);
+
+	/**
+	 * Runs every active ball on for a fixed time dt, in parallel, bouncing as
+	 * often as needed and stopping part way along a free flight. Then
+	 * observe(ball, position, velocity, thread) is called with the state at
+	 * the new time, so calling this repeatedly samples the ensemble at even
+	 * steps in time rather than at collisions.
+	 *
+	 * A ball whose flight is not a finite number (as for the finite check of
+	 * HealthMonitor), which makes no progress for several flights in a row
+	 * (as for the progress check), or which needs more than maxBounces
+	 * bounces in the step, is stuck or broken: it is left where it was,
+	 * flagged in lost and not observed, ready for Compact.
+	 *
+	 * ITable & table: table to run on.
+	 * double dt: time to run every ball on by.
+	 * observe: function called for every ball at the end of the step.
+	 * std::vector<char> & lost: set to a flag for each active ball, non-zero
+	 * if it was lost.
+	 * int maxBounces: most bounces a ball may take in one step.
+	 * return: number of balls lost.
+	 */
+	int Advance(ITable & table, double dt,
+		const std::function<void(int ball, const Vector & position, const Vector & velocity, int thread)> & observe,
+		std::vector<char> & lost, int maxBounces = 1 << 20);
+
+	/**
+	 * Removes every active ball with a non-zero flag from the active set,
+	 * keeping the order of the others. Removed balls are moved past
+	 * GetActive() rather than deleted.
+	 *
+	 * std::vector<char> & finished: flag for each active ball.
+	 */
+	void Compact(const std::vector<char> & finished);
+
+private:
+	// Structure of arrays, indexed by ball.
+	std::vector<double> fPX;
+	std::vector<double> fPY;
+	std::vector<double> fVX;
+	std::vector<double> fVY;
+	std::vector<int> fBounces;
+	std::vector<double> fTime;
+
+	// Balls [0, fActive) are still live.
+	int fActive;
+};
+
+#endif
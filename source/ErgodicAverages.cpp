@@ -0,0 +1,154 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the BatchMeans and ErgodicAverages classes.
+ */
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "ErgodicAverages.h"
+#include "Birkhoff.h"
+
+BatchMeans::BatchMeans(int size, int batches) :
+	fSize(size), fBatches(batches < 4 ? 4 : batches + batches % 2), fCount(0), fLength(1), fFull(0), fFill(0),
+	fBatch(size, 0), fSums(size * fBatches, 0), fTotal(size, 0)
+{}
+
+BatchMeans::~BatchMeans()
+{}
+
+bool BatchMeans::Next()
+{
+	fCount++;
+
+	if (++fFill != fLength)
+		return false;
+
+	//Batch complete.
+	for (int i = 0; i != fSize; i++)
+	{
+		fSums[fFull * fSize + i] = fBatch[i];
+		fTotal[i] += fBatch[i];
+		fBatch[i] = 0;
+	}
+	fFill = 0;
+
+	//All full: merge pairs, and double the batch length.
+	if (++fFull == fBatches)
+	{
+		for (int b = 0; b != fBatches / 2; b++)
+		{
+			for (int i = 0; i != fSize; i++)
+				fSums[b * fSize + i] = fSums[2 * b * fSize + i] + fSums[(2 * b + 1) * fSize + i];
+		}
+
+		fFull = fBatches / 2;
+		fLength *= 2;
+	}
+
+	return true;
+}
+
+double BatchMeans::Mean(int i) const
+{
+	long complete = fCount - fFill;
+	return complete > 0 ? fTotal[i] / complete : 0;
+}
+
+double BatchMeans::Error(int i) const
+{
+	if (fFull < fBatches / 2)
+		return std::numeric_limits<double>::infinity();
+
+	double mean = 0;
+	for (int b = 0; b != fFull; b++)
+		mean += fSums[b * fSize + i];
+	mean /= fFull * (double) fLength;
+
+	double variance = 0;
+	for (int b = 0; b != fFull; b++)
+	{
+		double d = fSums[b * fSize + i] / fLength - mean;
+		variance += d * d;
+	}
+	variance /= fFull - 1;
+
+	return std::sqrt(variance / fFull);
+}
+
+ErgodicAverages::ErgodicAverages(ITable & table, int bins, double tolerance) :
+	fTable(&table), fBins(bins > 0 ? bins : 1), fTolerance(tolerance), fLength(table.BoundaryLength()),
+	fConverged(false), fMeans(1 + 2 * fBins)
+{}
+
+ErgodicAverages::~ErgodicAverages()
+{}
+
+bool ErgodicAverages::Add(const Bounce & bounce)
+{
+	if (bounce.fIndex == 0)
+		return fConverged;
+
+	double s, p;
+	BirkhoffCoordinates(*fTable, bounce.fPosition, bounce.fVelocity, s, p);
+
+	int sBin = (int)(s / fLength * fBins);
+	int aBin = (int)((std::asin(p) / M_PI + 0.5) * fBins);
+
+	fMeans.Add(0, bounce.fLength);
+	fMeans.Add(1 + std::min(std::max(sBin, 0), fBins - 1), 1);
+	fMeans.Add(1 + fBins + std::min(std::max(aBin, 0), fBins - 1), 1);
+
+	//Errors only change when a batch is complete, and can't be trusted
+	//until the batches are long enough to span a few collision times.
+	if (fMeans.Next() && fMeans.GetBatchLength() >= 32)
+	{
+		int worst;
+		fConverged = Worst(worst) <= fTolerance;
+	}
+
+	return fConverged;
+}
+
+double ErgodicAverages::Worst(int & worst) const
+{
+	double mean = fMeans.Mean(0);
+	double largest = mean > 0 ? 2 * fMeans.Error(0) / mean : std::numeric_limits<double>::infinity();
+	worst = 0;
+
+	//Probability of each bin, against that of an even spread.
+	for (int b = 0; b != 2 * fBins; b++)
+	{
+		double error = 2 * fMeans.Error(1 + b) * fBins;
+		if (!(error <= largest))
+		{
+			largest = error;
+			worst = b < fBins ? 1 : 2;
+		}
+	}
+
+	return largest;
+}
+
+void ErgodicAverages::Write(FILE * file) const
+{
+	fprintf(file, "Mean free path: %f +- %f (two standard errors, batches of %li bounces).\n", fMeans.Mean(0),
+		2 * fMeans.Error(0), fMeans.GetBatchLength());
+}
+
+void ErgodicAverages::WriteDistributions(FILE * file) const
+{
+	fprintf(file, "%-24s%-24s%-24s%-24s%-24s%-24s\n", "s", "sdensity", "serror", "angle", "adensity", "aerror");
+
+	double sWidth = fLength / fBins;
+	double aWidth = M_PI / fBins;
+
+	for (int b = 0; b != fBins; b++)
+	{
+		fprintf(file, "%-24.15f%-24.15f%-24.15f%-24.15f%-24.15f%-24.15f\n", (b + 0.5) * sWidth,
+			fMeans.Mean(1 + b) / sWidth, 2 * fMeans.Error(1 + b) / sWidth, (b + 0.5) * aWidth - M_PI / 2,
+			fMeans.Mean(1 + fBins + b) / aWidth, 2 * fMeans.Error(1 + fBins + b) / aWidth);
+	}
+}
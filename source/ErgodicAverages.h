@@ -0,0 +1,170 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the BatchMeans and ErgodicAverages classes.
+ */
+
+#ifndef _ERGODICAVERAGES_H
+#define _ERGODICAVERAGES_H
+
+#include <cstdio>
+#include <vector>
+
+#include "ITable.h"
+#include "Trajectory.h"
+
+/**
+ * Running means of several observables along one trajectory, with error
+ * estimates from batch means. Successive samples are correlated, so the
+ * usual standard error is far too small; instead the samples are split into
+ * consecutive batches, and once the batches are much longer than the
+ * correlation time their means are close to independent.
+ *
+ * A fixed number of batches is kept. When they are all full, neighbouring
+ * pairs are merged and the batch length doubles, so memory stays the same
+ * however long the run, and the batches keep growing past the correlation
+ * time.
+ */
+class BatchMeans
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * int size: number of observables.
+	 * int batches: number of batches kept, even.
+	 */
+	BatchMeans(int size, int batches = 64);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~BatchMeans();
+
+	// Getters.
+	int GetSize() const { return fSize; }
+	long GetCount() const { return fCount; }
+	long GetBatchLength() const { return fLength; }
+
+	/**
+	 * Adds to the value of one observable for the current sample.
+	 * Observables not added to are 0 for the sample.
+	 *
+	 * int i: index of the observable.
+	 * double x: value to add.
+	 */
+	void Add(int i, double x) { fBatch[i] += x; }
+
+	/**
+	 * Ends the current sample.
+	 *
+	 * return: true if a batch was completed, when the errors change.
+	 */
+	bool Next();
+
+	/**
+	 * Mean of an observable over every sample.
+	 */
+	double Mean(int i) const;
+
+	/**
+	 * Standard error of the mean of an observable, from the spread of the
+	 * complete batches.
+	 *
+	 * return: the error, infinite until half the batches are full.
+	 */
+	double Error(int i) const;
+
+private:
+	int fSize;
+	int fBatches;
+	long fCount;
+
+	// Samples per batch, complete batches and samples in the current one.
+	long fLength;
+	int fFull;
+	long fFill;
+
+	// Sums over the current batch, the complete batches (fSize per batch)
+	// and every sample.
+	std::vector<double> fBatch;
+	std::vector<double> fSums;
+	std::vector<double> fTotal;
+};
+
+/**
+ * Time averages along a trajectory for choosing how long to run it: the
+ * mean free path and the distributions of the bounces round the edge and of
+ * the reflection angle, with batch mean errors (see BatchMeans). Bounces are
+ * added until every average is known to within a tolerance.
+ *
+ * The tolerance is relative: to the mean for the free path, and to the
+ * average density for the distributions (1 / L in arc length, 1 / pi in
+ * angle). An average is taken as known once twice its standard error (a
+ * 95% interval) is within the tolerance, and the batches are at least 32
+ * bounces long. For a table whose bounces fill it evenly both distributions
+ * tend to the invariant ones, uniform in arc length and cos(angle) / 2 in
+ * angle.
+ */
+class ErgodicAverages
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * ITable & table: table being run.
+	 * int bins: bins in each distribution.
+	 * double tolerance: relative tolerance, as above.
+	 */
+	ErgodicAverages(ITable & table, int bins, double tolerance);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~ErgodicAverages();
+
+	// Getters.
+	long GetCount() const { return fMeans.GetCount(); }
+	long GetBatchLength() const { return fMeans.GetBatchLength(); }
+	bool IsConverged() const { return fConverged; }
+	double GetFreePath() const { return fMeans.Mean(0); }
+
+	/**
+	 * Adds the next record of the trajectory. Record 0 (the start) is
+	 * skipped.
+	 *
+	 * Bounce & bounce: next record.
+	 * return: true once every average is within the tolerance.
+	 */
+	bool Add(const Bounce & bounce);
+
+	/**
+	 * Largest error of the averages relative to its tolerance scale (see
+	 * above), at two standard errors.
+	 *
+	 * int & worst: set to the observable with the largest error: 0 free
+	 * path, 1 arc length, 2 angle.
+	 * return: the error, infinite until there are enough batches.
+	 */
+	double Worst(int & worst) const;
+
+	/**
+	 * Writes the mean free path with its error.
+	 */
+	void Write(FILE * file) const;
+
+	/**
+	 * Writes both distributions with their errors, one bin per line.
+	 */
+	void WriteDistributions(FILE * file) const;
+
+private:
+	ITable * fTable;
+	int fBins;
+	double fTolerance;
+	double fLength;
+	bool fConverged;
+
+	// Free path, then the arc length bins, then the angle bins.
+	BatchMeans fMeans;
+};
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the EscapeStatistics class.
+ */
+
+#include "EscapeStatistics.h"
+
+EscapeStatistics::EscapeStatistics() :
+	fTimeBin(1), fEscaped(0), fCensored(0), fBounceSum(0), fTimeSum(0)
+{}
+
+EscapeStatistics::EscapeStatistics(int maxBounces, double timeBin) :
+	fBounceCounts(maxBounces, 0), fTimeCounts(maxBounces, 0), fTimeBin(timeBin),
+	fEscaped(0), fCensored(0), fBounceSum(0), fTimeSum(0)
+{}
+
+EscapeStatistics::~EscapeStatistics()
+{}
+
+void EscapeStatistics::Record(int bounces, double time)
+{
+	fEscaped++;
+	fBounceSum += bounces;
+	fTimeSum += time;
+
+	if (bounces >= 1 && bounces <= (int)fBounceCounts.size())
+		fBounceCounts[bounces - 1]++;
+
+	//Escapes past the last time bin are still counted in fEscaped.
+	int bin = (int)(time / fTimeBin);
+	if (bin >= 0 && bin < (int)fTimeCounts.size())
+		fTimeCounts[bin]++;
+}
+
+void EscapeStatistics::Censor(long count)
+{
+	fCensored += count;
+}
+
+void EscapeStatistics::Merge(const EscapeStatistics & other)
+{
+	for (unsigned int i = 0; i != fBounceCounts.size() && i != other.fBounceCounts.size(); i++)
+		fBounceCounts[i] += other.fBounceCounts[i];
+	for (unsigned int i = 0; i != fTimeCounts.size() && i != other.fTimeCounts.size(); i++)
+		fTimeCounts[i] += other.fTimeCounts[i];
+
+	fEscaped += other.fEscaped;
+	fCensored += other.fCensored;
+	fBounceSum += other.fBounceSum;
+	fTimeSum += other.fTimeSum;
+}
+
+void EscapeStatistics::Write(FILE * file) const
+{
+	double total = fEscaped + fCensored;
+	long bounceSurvivors = fEscaped + fCensored, timeSurvivors = fEscaped + fCensored;
+
+	fprintf(file, "%-10s%-12s%-24s%-24s%-12s%-24s\n", "n", "count", "survival", "t", "tcount", "tsurvival");
+
+	for (unsigned int i = 0; i != fBounceCounts.size(); i++)
+	{
+		bounceSurvivors -= fBounceCounts[i];
+		timeSurvivors -= fTimeCounts[i];
+
+		fprintf(file, "%-10i%-12li%-24.15f%-24.15f%-12li%-24.15f\n",
+			i + 1, fBounceCounts[i], bounceSurvivors / total,
+			(i + 1) * fTimeBin, fTimeCounts[i], timeSurvivors / total);
+	}
+}
@@ -0,0 +1,87 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the EscapeStatistics class.
+ */
+
+#ifndef _ESCAPESTATISTICS_H
+#define _ESCAPESTATISTICS_H
+
+#include <cstdio>
+#include <vector>
+
+/**
+ * Histograms of escape times from an open table, counted both in bounces and
+ * in continuous time. Each thread of an ensemble run fills its own copy,
+ * which are merged at the end, and the survival probability curves are
+ * worked out when writing.
+ */
+class EscapeStatistics
+{
+public:
+	/**
+	 * Empty constructor, histograms are empty.
+	 */
+	EscapeStatistics();
+	/**
+	 * Constructor for histograms counting escapes up to maxBounces bounces,
+	 * with the time histogram having the same number of bins of width
+	 * timeBin.
+	 */
+	EscapeStatistics(int maxBounces, double timeBin);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~EscapeStatistics();
+
+	// Getters.
+	int GetMaxBounces() const { return fBounceCounts.size(); }
+	double GetTimeBin() const { return fTimeBin; }
+	long GetEscaped() const { return fEscaped; }
+	long GetCensored() const { return fCensored; }
+	double GetMeanBounces() const { return fEscaped ? fBounceSum / fEscaped : 0; }
+	double GetMeanTime() const { return fEscaped ? fTimeSum / fEscaped : 0; }
+
+	/**
+	 * Records one ball escaping.
+	 *
+	 * int bounces: number of collisions up to and including the escape.
+	 * double time: time of flight until the escape.
+	 */
+	void Record(int bounces, double time);
+
+	/**
+	 * Records balls which had not escaped when the run was stopped.
+	 *
+	 * long count: number of balls still on the table.
+	 */
+	void Censor(long count);
+
+	/**
+	 * Adds the counts from other, which must have the same binning.
+	 */
+	void Merge(const EscapeStatistics & other);
+
+	/**
+	 * Writes the histograms and survival probabilities to file. Survival
+	 * is the fraction of all balls (escaped or censored) which have not yet
+	 * escaped at the end of each bin.
+	 *
+	 * FILE * file: file stream to write to.
+	 */
+	void Write(FILE * file) const;
+
+private:
+	// Escapes at each bounce number, index 0 is bounce 1.
+	std::vector<long> fBounceCounts;
+	// Escapes in each time bin.
+	std::vector<long> fTimeCounts;
+	double fTimeBin;
+
+	long fEscaped;
+	long fCensored;
+	double fBounceSum;
+	double fTimeSum;
+};
+
+#endif
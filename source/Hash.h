@@ -0,0 +1,30 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the shared hash function.
+ */
+
+#ifndef _HASH_H
+#define _HASH_H
+
+#include <cstdint>
+
+/**
+ * Mixes the bits of a 64 bit key (the splitmix64 finaliser), so that keys
+ * differing only in a few low bits land far apart in a hash table indexed
+ * by the low bits of the result.
+ *
+ * uint64_t key: key to mix.
+ * return: mixed key.
+ */
+inline uint64_t Hash(uint64_t key)
+{
+	key ^= key >> 30;
+	key *= 0xbf58476d1ce4e5b9ULL;
+	key ^= key >> 27;
+	key *= 0x94d049bb133111ebULL;
+	key ^= key >> 31;
+	return key;
+}
+
+#endif
@@ -0,0 +1,163 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the HealthMonitor class.
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "HealthMonitor.h"
+
+HealthMonitor::HealthMonitor(ITable & table, Policy policy, double tolerance) :
+	fTable(&table), fPolicy(policy), fTolerance(tolerance), fEdge(table.BoundaryLength()), fSpeed(0),
+	fRetrace(0, 0), fBounces(0), fRepairs(0), fAborted(false)
+{
+	for (int c = 0; c != kCheckCount; c++)
+		fFailures[c] = 0;
+}
+
+HealthMonitor::~HealthMonitor()
+{}
+
+void HealthMonitor::Start(const Vector & velocity)
+{
+	fSpeed = velocity.Mod();
+	fRetrace = velocity;
+}
+
+bool HealthMonitor::Inspect(const Vector & position, Vector & collision, const Vector & incoming, Vector & velocity)
+{
+	fBounces++;
+
+	bool healthy = true;
+
+	//Not finite or stuck: nothing else can be checked, so retrace the path
+	//from the last good bounce.
+	bool finite = std::isfinite(collision.fX) && std::isfinite(collision.fY) && std::isfinite(velocity.fX) &&
+		std::isfinite(velocity.fY);
+	bool progress = finite && (collision - position).Dot(incoming) > 0;
+
+	if (!finite || !progress)
+	{
+		healthy = Fail(finite ? kProgress : kFinite);
+
+		if (fPolicy == kRepair)
+		{
+			collision = position;
+			velocity = -fRetrace;
+			fRepairs++;
+		}
+
+		return healthy;
+	}
+
+	//Distance from the nearest point on the edge.
+	Vector edge = fTable->BoundaryPoint(fTable->BoundaryPosition(collision));
+	if ((edge - collision).Mod() > fTolerance * fEdge)
+	{
+		healthy = Fail(kBoundary) && healthy;
+
+		if (fPolicy == kRepair)
+		{
+			collision = edge;
+			fRepairs++;
+		}
+	}
+
+	double speed = velocity.Mod();
+	if (std::abs(speed - fSpeed) > fTolerance * fSpeed)
+	{
+		healthy = Fail(kSpeed) && healthy;
+
+		if (fPolicy == kRepair)
+		{
+			velocity = velocity * (fSpeed / speed);
+			fRepairs++;
+		}
+	}
+
+	fRetrace = incoming;
+
+	return healthy;
+}
+
+void HealthMonitor::Merge(const HealthMonitor & other)
+{
+	fBounces += other.fBounces;
+	for (int c = 0; c != kCheckCount; c++)
+		fFailures[c] += other.fFailures[c];
+	fRepairs += other.fRepairs;
+	fAborted = fAborted || other.fAborted;
+}
+
+bool HealthMonitor::Fail(Check check)
+{
+	fFailures[check]++;
+
+	if (fPolicy == kAbort)
+	{
+		fAborted = true;
+		return false;
+	}
+
+	return true;
+}
+
+void HealthMonitor::Write(FILE * file) const
+{
+	long failures = 0;
+	for (int c = 0; c != kCheckCount; c++)
+		failures += fFailures[c];
+
+	fprintf(file, "Health checks: %li bounces, %li failed", fBounces, failures);
+
+	if (failures > 0)
+	{
+		fprintf(file, " (");
+		for (int c = 0, shown = 0; c != kCheckCount; c++)
+		{
+			if (fFailures[c] > 0)
+				fprintf(file, "%s%s %li", shown++ ? ", " : "", CheckName((Check) c), fFailures[c]);
+		}
+		fprintf(file, ")");
+	}
+
+	if (fRepairs > 0)
+		fprintf(file, ", %li repairs", fRepairs);
+
+	fprintf(file, ".\n");
+
+	if (fAborted)
+		fprintf(file, "Run stopped at the first failure, set BILLIARDS_HEALTH=repair or ignore to carry on.\n");
+}
+
+const char * HealthMonitor::CheckName(Check check)
+{
+	switch (check)
+	{
+		case kFinite:
+			return "finite";
+		case kProgress:
+			return "progress";
+		case kBoundary:
+			return "boundary";
+		case kSpeed:
+			return "speed";
+		default:
+			return "";
+	}
+}
+
+HealthMonitor::Policy HealthMonitor::DefaultPolicy()
+{
+	const char * env = std::getenv("BILLIARDS_HEALTH");
+
+	if (env && std::strcmp(env, "ignore") == 0)
+		return kIgnore;
+	if (env && std::strcmp(env, "repair") == 0)
+		return kRepair;
+
+	return kAbort;
+}
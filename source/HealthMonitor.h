@@ -0,0 +1,144 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the HealthMonitor class.
+ */
+
+#ifndef _HEALTHMONITOR_H
+#define _HEALTHMONITOR_H
+
+#include <cstdio>
+
+#include "ITable.h"
+#include "Vector.h"
+
+/**
+ * Cheap checks on every bounce of a trajectory, to catch a run which has
+ * gone wrong (a ball stuck in a corner, a NaN from a tangent hit, a ball
+ * which has left the table) before it writes hours of garbage. Each bounce
+ * is checked for:
+ *
+ * - finite: the collision and velocity are finite numbers.
+ * - progress: the ball moved forward to reach the collision.
+ * - boundary: the collision lies on the table edge.
+ * - speed: the speed is the same as at the start.
+ *
+ * What happens when a check fails depends on the policy. kIgnore only counts
+ * it. kRepair counts it and puts the state right: a ball which is stuck or
+ * not finite retraces its path (as from a corner), a collision off the edge
+ * is moved onto it and the speed is rescaled. kAbort counts it and tells the
+ * caller to stop.
+ *
+ * The default policy is taken from the BILLIARDS_HEALTH environment
+ * variable ("ignore", "repair" or "abort"), and is kAbort if it isn't set.
+ */
+class HealthMonitor
+{
+public:
+	enum Policy
+	{
+		kIgnore,
+		kRepair,
+		kAbort
+	};
+
+	enum Check
+	{
+		kFinite,
+		kProgress,
+		kBoundary,
+		kSpeed,
+		kCheckCount
+	};
+
+	/**
+	 * Constructor.
+	 *
+	 * ITable & table: table the trajectory runs on.
+	 * Policy policy: what to do when a check fails.
+	 * double tolerance: relative tolerance for the speed, and for the
+	 * distance from the edge as a fraction of the edge length.
+	 */
+	HealthMonitor(ITable & table, Policy policy = DefaultPolicy(), double tolerance = 1e-9);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~HealthMonitor();
+
+	// Getters.
+	Policy GetPolicy() const { return fPolicy; }
+	long GetBounces() const { return fBounces; }
+	long GetFailures(Check check) const { return fFailures[check]; }
+	long GetRepairs() const { return fRepairs; }
+	bool IsAborted() const { return fAborted; }
+
+	/**
+	 * Sets the starting state of a new trajectory, which the speed is
+	 * checked against. The counters are kept.
+	 *
+	 * Vector & velocity: initial velocity of the ball.
+	 */
+	void Start(const Vector & velocity);
+
+	/**
+	 * Checks one bounce, and repairs it if the policy is kRepair.
+	 *
+	 * Vector & position: where the ball was before the bounce.
+	 * Vector & collision: collision point, may be changed by a repair.
+	 * Vector & incoming: velocity arriving at the collision.
+	 * Vector & velocity: velocity leaving the collision, may be changed by a
+	 * repair.
+	 * return: false if the run should stop (kAbort and a check failed).
+	 */
+	bool Inspect(const Vector & position, Vector & collision, const Vector & incoming, Vector & velocity);
+
+	/**
+	 * Adds the counts of another monitor, e.g. one per ball or per thread,
+	 * so they can be written as one.
+	 */
+	void Merge(const HealthMonitor & other);
+
+	/**
+	 * Prints the number of bounces checked, the failures of each check and
+	 * the repairs made.
+	 *
+	 * FILE * file: stream to print to, e.g. stdout.
+	 */
+	void Write(FILE * file) const;
+
+	/**
+	 * Name of a check, for printing.
+	 */
+	static const char * CheckName(Check check);
+
+	/**
+	 * Policy from the BILLIARDS_HEALTH environment variable, kAbort if it
+	 * isn't set or isn't recognised.
+	 */
+	static Policy DefaultPolicy();
+
+private:
+	/**
+	 * Counts a failed check.
+	 *
+	 * return: false if the run should stop.
+	 */
+	bool Fail(Check check);
+
+	ITable * fTable;
+	Policy fPolicy;
+	double fTolerance;
+	double fEdge;
+
+	// Speed at the start, and the incoming velocity of the last good bounce
+	// for retracing.
+	double fSpeed;
+	Vector fRetrace;
+
+	long fBounces;
+	long fFailures[kCheckCount];
+	long fRepairs;
+	bool fAborted;
+};
+
+#endif
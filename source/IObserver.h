@@ -0,0 +1,49 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the IObserver interface.
+ */
+
+#ifndef _IOBSERVER_H
+#define _IOBSERVER_H
+
+#include <cstdio>
+
+#include "Trajectory.h"
+
+/**
+ * Interface for analyses which can be attached to a Pipeline, so that
+ * several of them share a single run of the simulation. Each observer is
+ * handed every record of the trajectory in turn.
+ */
+class IObserver
+{
+public:
+	// Always put in a virtual destructor...
+	virtual ~IObserver() {}
+
+	/**
+	 * Short name of the analysis, for the cost report.
+	 *
+	 * return: name of the observer.
+	 */
+	virtual const char * Name() = 0;
+
+	/**
+	 * Called with each record of the trajectory in order, starting with
+	 * record 0 (the starting state).
+	 *
+	 * Bounce & bounce: next record of the trajectory.
+	 */
+	virtual void Observe(const Bounce & bounce) = 0;
+
+	/**
+	 * Called once the run is over, to write any output files and print a
+	 * summary of the results.
+	 *
+	 * FILE * file: stream to print the summary to, e.g. stdout.
+	 */
+	virtual void Finish(FILE * file) = 0;
+};
+
+#endif
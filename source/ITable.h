@@ -55,6 +55,72 @@ public:
 	* return: vector position of collision with the table edge.
  	*/
 	virtual Vector CollisionPoint(const Vector & initial, const Vector & velocity) = 0;
+
+	/**
+	 * BoundaryPosition returns the arc length coordinate of a point on the
+	 * table edge. The coordinate increases going round the edge with the
+	 * inside of the table on the left, from 0 up to BoundaryLength(). Each
+	 * table documents where its coordinate starts.
+	 *
+	 * Vector & collision: point on the wall of the table.
+	 * return: arc length along the table edge up to collision.
+	 */
+	virtual double BoundaryPosition(const Vector & collision) = 0;
+
+	/**
+	 * BoundaryLength returns the total length of the table edge.
+	 *
+	 * return: perimeter of the table (including any inner walls).
+	 */
+	virtual double BoundaryLength() = 0;
+
+	/**
+	 * BoundaryPoint is the inverse of BoundaryPosition, returning the point
+	 * on the table edge at a given arc length.
+	 *
+	 * double s: arc length round the edge, from 0 to BoundaryLength().
+	 * return: point on the wall of the table.
+	 */
+	virtual Vector BoundaryPoint(double s) = 0;
+
+	/**
+	 * Normal returns the unit surface normal at a point on the table edge,
+	 * pointing into the table. The tangent in the direction of increasing
+	 * BoundaryPosition is this rotated by -pi/2, i.e. (fY, -fX).
+	 *
+	 * Vector & collision: point on the wall of the table.
+	 * return: inward unit normal at collision.
+	 */
+	virtual Vector Normal(const Vector & collision) = 0;
+
+	/**
+	 * Component returns which wall of the table a point on the edge is on,
+	 * where each wall is a smooth piece of the edge (e.g. one side of a
+	 * rectangle). Walls are numbered from 0 in order of BoundaryPosition.
+	 *
+	 * Vector & collision: point on the wall of the table.
+	 * return: index of the wall.
+	 */
+	virtual int Component(const Vector & collision) = 0;
+
+	/**
+	 * ComponentCount returns the number of walls, so Component is always
+	 * from 0 to ComponentCount() - 1.
+	 *
+	 * return: number of walls.
+	 */
+	virtual int ComponentCount() = 0;
+
+	/**
+	 * Curvature returns the curvature of the table edge at a point. This is
+	 * positive where the edge bends round towards the inside of the table
+	 * (focusing, like the circle), negative where it bends away (dispersing,
+	 * like the Lorentz scatterer) and zero on flat walls.
+	 *
+	 * Vector & collision: point on the wall of the table.
+	 * return: 1/radius of curvature, signed as above.
+	 */
+	virtual double Curvature(const Vector & collision) = 0;
 };
 
 #endif
@@ -191,3 +191,107 @@ Vector LorentzTable::CollisionPoint(const Vector & initial, const Vector & veloc
 
 	return Vector(0,0);
 }
+
+double LorentzTable::BoundaryPosition(const Vector & collision)
+{
+	double angle;
+
+	switch (Component(collision))
+	{
+		case 0:
+			return collision.fY + fY;
+		case 1:
+			return 2*fY + (fX - collision.fX);
+		case 2:
+			return 2*fY + 2*fX + (fY - collision.fY);
+		case 3:
+			return 4*fY + 2*fX + (collision.fX + fX);
+	}
+
+	//Inner circle, clockwise so the table is on the left.
+	angle = -std::atan2(collision.fY, collision.fX);
+	if (angle < 0)
+		angle += 2*M_PI;
+
+	return 4*fX + 4*fY + fRadius * angle;
+}
+
+double LorentzTable::BoundaryLength()
+{
+	return 4*fX + 4*fY + 2*M_PI*fRadius;
+}
+
+Vector LorentzTable::BoundaryPoint(double s)
+{
+	//Outer walls in the same order as the rectangle.
+	if (s < 2*fY)
+		return Vector(fX, s - fY);
+	s -= 2*fY;
+
+	if (s < 2*fX)
+		return Vector(fX - s, fY);
+	s -= 2*fX;
+
+	if (s < 2*fY)
+		return Vector(-fX, fY - s);
+	s -= 2*fY;
+
+	if (s < 2*fX)
+		return Vector(-fX + s, -fY);
+	s -= 2*fX;
+
+	//Inner circle, clockwise from (r,0).
+	double angle = -s / fRadius;
+
+	return Vector(fRadius * std::cos(angle), fRadius * std::sin(angle));
+}
+
+Vector LorentzTable::Normal(const Vector & collision)
+{
+	switch (Component(collision))
+	{
+		case 0:
+			return Vector(-1, 0);
+		case 1:
+			return Vector(0, -1);
+		case 2:
+			return Vector(1, 0);
+		case 3:
+			return Vector(0, 1);
+	}
+
+	//Inner circle normal points out of the circle.
+	return collision / collision.Mod();
+}
+
+int LorentzTable::Component(const Vector & collision)
+{
+	double right = fX - collision.fX;
+	double top = fY - collision.fY;
+	double left = collision.fX + fX;
+	double bottom = collision.fY + fY;
+
+	//Closer to the inner circle than any wall:
+	double circle = std::abs(collision.Mod() - fRadius);
+	if (circle < right && circle < top && circle < left && circle < bottom)
+		return 4;
+
+	//Otherwise as rectangle.
+	if (right <= top && right <= left && right <= bottom)
+		return 0;
+	else if (top <= left && top <= bottom)
+		return 1;
+	else if (left <= bottom)
+		return 2;
+
+	return 3;
+}
+
+double LorentzTable::Curvature(const Vector & collision)
+{
+	//Inner circle bends away from the inside of the table.
+	if (Component(collision) == 4)
+		return -1 / fRadius;
+
+	return 0;
+}
@@ -4,6 +4,9 @@
  * Header file for the LorentzTable class.
  */
 
+#ifndef _LORENTZTABLE_H
+#define _LORENTZTABLE_H
+
 #include "ITable.h"
 
 /**
@@ -38,10 +41,23 @@ public:
 	double AngleIncidence(const Vector & collision, const Vector & velocity);
 	Vector ReflectVector(const Vector & collision, const Vector & velocity);
 	Vector CollisionPoint(const Vector & initial, const Vector & velocity);
+	// Boundary coordinate runs round the rectangle as in RectangleTable,
+	// then clockwise round the inner circle starting from (radius,0).
+	double BoundaryPosition(const Vector & collision);
+	double BoundaryLength();
+	Vector BoundaryPoint(double s);
+	Vector Normal(const Vector & collision);
+	// Walls are 0=right 1=top 2=left 3=bottom 4=inner circle.
+	int Component(const Vector & collision);
+	int ComponentCount() { return 5; }
+	double Curvature(const Vector & collision);
 
 private:
+
 	//Private members.
 	double fX;
 	double fY;
 	double fRadius;	
 };
+
+#endif
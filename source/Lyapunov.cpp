@@ -0,0 +1,121 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the LyapunovSpectrum class.
+ */
+
+#include <cmath>
+
+#include "Lyapunov.h"
+
+LyapunovSpectrum::LyapunovSpectrum(ITable * table, const Vector & position, const Vector & velocity) :
+	fTable(table), fPosition(position), fVelocity(velocity), fBounces(0), fTime(0)
+{
+	fTangent[0] = Tangent(Vector(1, 0), Vector(0, 0));
+	fTangent[1] = Tangent(Vector(0, 1), Vector(0, 0));
+	fTangent[2] = Tangent(Vector(0, 0), Vector(1, 0));
+	fTangent[3] = Tangent(Vector(0, 0), Vector(0, 1));
+
+	for (int i = 0; i != 4; i++)
+		fSum[i] = 0;
+}
+
+LyapunovSpectrum::~LyapunovSpectrum()
+{}
+
+void LyapunovSpectrum::Advance(int bounces)
+{
+	Vector collision;
+
+	for (int j = 0; j != bounces; j++)
+	{
+		collision = fTable->CollisionPoint(fPosition, fVelocity);
+		Follow(collision, fVelocity, fTable->ReflectVector(collision, fVelocity),
+			(collision - fPosition).Mod() / fVelocity.Mod());
+	}
+
+	Orthonormalise();
+}
+
+void LyapunovSpectrum::Follow(const Vector & collision, const Vector & incoming, const Vector & outgoing, double time)
+{
+	//Tangent vectors are taken to the moment of collision, then through
+	//the bounce.
+	for (int i = 0; i != 4; i++)
+	{
+		fTangent[i].Flight(time);
+		fTangent[i].Bounce(*fTable, collision, incoming);
+	}
+
+	fPosition = collision;
+	fVelocity = outgoing;
+	fTime += time;
+	fBounces++;
+
+	//The other vectors are found by taking the largest off them, so once it
+	//has grown by more than the square root of the double precision they
+	//are lost in its rounding error. Re-orthonormalise well before that,
+	//however long the caller waits.
+	const double most = 1e6;
+
+	for (int i = 0; i != 4; i++)
+	{
+		if (!(fTangent[i].Mod() < most))
+		{
+			Orthonormalise();
+			break;
+		}
+	}
+}
+
+void LyapunovSpectrum::Orthonormalise()
+{
+	double length;
+
+	//Modified Gram-Schmidt, each vector made orthogonal to those before.
+	for (int i = 0; i != 4; i++)
+	{
+		for (int k = 0; k != i; k++)
+			fTangent[i] = fTangent[i] - fTangent[k] * fTangent[i].Dot(fTangent[k]);
+
+		length = fTangent[i].Mod();
+
+		//A vector that has collapsed onto those before it has no length
+		//left to measure. It is replaced by the coordinate axis furthest
+		//from them, and its stretching since the last time is not counted.
+		if (!(length > 0) || !std::isfinite(length))
+		{
+			fTangent[i] = Axis(i);
+			length = fTangent[i].Mod();
+		}
+		else
+		{
+			fSum[i] += std::log(length);
+		}
+
+		fTangent[i] = fTangent[i] * (1 / length);
+	}
+}
+
+Tangent LyapunovSpectrum::Axis(int i) const
+{
+	Tangent best;
+	double bestLength = -1;
+
+	//The earlier vectors are orthonormal, so at least one axis is at least
+	//1/2 away from them.
+	for (int a = 0; a != 4; a++)
+	{
+		Tangent axis(Vector(a == 0, a == 1), Vector(a == 2, a == 3));
+		for (int k = 0; k != i; k++)
+			axis = axis - fTangent[k] * axis.Dot(fTangent[k]);
+
+		if (axis.Mod() > bestLength)
+		{
+			best = axis;
+			bestLength = axis.Mod();
+		}
+	}
+
+	return best;
+}
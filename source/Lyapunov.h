@@ -0,0 +1,116 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the LyapunovSpectrum class.
+ */
+
+#ifndef _LYAPUNOV_H
+#define _LYAPUNOV_H
+
+#include "ITable.h"
+#include "Tangent.h"
+#include "Vector.h"
+
+/**
+ * Works out the Lyapunov spectrum of a single trajectory by carrying four
+ * tangent vectors along with it (see Tangent), rather than running nearby
+ * trajectories as InnerChaos does. Every so often the tangent vectors are
+ * re-orthonormalised by Gram-Schmidt (a QR decomposition); the logs of the
+ * stretching factors summed over the run, divided by the time, give the
+ * exponents from largest to smallest.
+ *
+ * For a billiard the spectrum is (l, 0, 0, -l): one zero along the flow and
+ * one for changes in speed, and the largest exponent l is zero for
+ * integrable tables such as the circle and ellipse.
+ */
+class LyapunovSpectrum
+{
+public:
+	/**
+	 * Constructor, starting the trajectory from the given position and
+	 * velocity with the tangent vectors along the four coordinate axes.
+	 *
+	 * ITable * table: table to run on, not owned.
+	 * Vector & position: initial position of the ball.
+	 * Vector & velocity: initial velocity of the ball.
+	 */
+	LyapunovSpectrum(ITable * table, const Vector & position, const Vector & velocity);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~LyapunovSpectrum();
+
+	/**
+	 * Runs the trajectory and tangent vectors on for a number of bounces,
+	 * then re-orthonormalises the tangent vectors and adds the stretching
+	 * onto the sums. Re-orthonormalising every few bounces is enough; the
+	 * tangent vectors are also re-orthonormalised on the way whenever one
+	 * has grown too large (see Follow), so long gaps are safe too.
+	 *
+	 * int bounces: number of bounces before re-orthonormalising.
+	 */
+	void Advance(int bounces);
+
+	/**
+	 * Carries the tangent vectors through one bounce of a trajectory which
+	 * is being run elsewhere (e.g. by a Pipeline), instead of by Advance.
+	 * Call Orthonormalise every few bounces as Advance does. If a tangent
+	 * vector grows by more than 1e6 it is done here, whatever the interval.
+	 *
+	 * Vector & collision: point of collision.
+	 * Vector & incoming: velocity before the collision.
+	 * Vector & outgoing: velocity after the collision.
+	 * double time: time of flight up to the collision.
+	 */
+	void Follow(const Vector & collision, const Vector & incoming, const Vector & outgoing, double time);
+
+	/**
+	 * Gram-Schmidt on the tangent vectors, adding the log of each length
+	 * onto its sum before normalising. A vector left with no length is
+	 * replaced rather than adding -inf.
+	 */
+	void Orthonormalise();
+
+	// Getters.
+	Vector GetPosition() const { return fPosition; }
+	Vector GetVelocity() const { return fVelocity; }
+	long GetBounces() const { return fBounces; }
+	double GetTime() const { return fTime; }
+
+	/**
+	 * Estimate of an exponent so far, per unit time.
+	 *
+	 * int i: exponent index 0-3, largest first.
+	 * return: exponent, or 0 before any time has passed.
+	 */
+	double GetExponent(int i) const { return fTime > 0 ? fSum[i] / fTime : 0; }
+	/**
+	 * Estimate of an exponent so far, per bounce.
+	 *
+	 * int i: exponent index 0-3, largest first.
+	 * return: exponent, or 0 before any bounces.
+	 */
+	double GetBounceExponent(int i) const { return fBounces > 0 ? fSum[i] / fBounces : 0; }
+
+private:
+	/**
+	 * Coordinate axis with the most left over once the tangent vectors
+	 * before i are taken off it, to replace a collapsed vector i.
+	 */
+	Tangent Axis(int i) const;
+
+	ITable * fTable;
+
+	// Reference trajectory.
+	Vector fPosition;
+	Vector fVelocity;
+
+	// Tangent vectors, and sum of log stretching for each.
+	Tangent fTangent[4];
+	double fSum[4];
+
+	long fBounces;
+	double fTime;
+};
+
+#endif
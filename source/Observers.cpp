@@ -0,0 +1,343 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the observers which can be attached to a Pipeline.
+ */
+
+#include <cmath>
+
+#include "Observers.h"
+#include "Birkhoff.h"
+
+RawObserver::RawObserver(ITable & table, const char * filename) :
+	fTable(&table), fFilename(filename)
+{
+	fFile = fopen(filename, "w");
+
+	if (fFile)
+		fprintf(fFile, "%-10s%-20s%-20s%-20s%-20s%-20s%-20s%-20s%-20s%-20s\n", "i", "x", "y", "mp", "pa", "a", "vx", "vy", "mv", "va");
+}
+
+RawObserver::~RawObserver()
+{
+	if (fFile)
+		fclose(fFile);
+}
+
+void RawObserver::Observe(const Bounce & bounce)
+{
+	if (!fFile)
+		return;
+
+	//Same angle as InnerRun: the velocity's for the starting state.
+	double angle = bounce.fIndex > 0 ?
+		std::fmod(fTable->AngleIncidence(bounce.fPosition, bounce.fIncoming), 2*M_PI) : bounce.fVelocity.Arg();
+
+	fprintf(fFile, "%-10li%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f\n",
+		bounce.fIndex, bounce.fPosition.fX, bounce.fPosition.fY, bounce.fPosition.Mod(), bounce.fPosition.Arg(),
+		angle, bounce.fVelocity.fX, bounce.fVelocity.fY, bounce.fVelocity.Mod(), bounce.fVelocity.Arg());
+}
+
+void RawObserver::Finish(FILE * file)
+{
+	if (fFile)
+	{
+		fclose(fFile);
+		fFile = 0;
+		fprintf(file, "Raw output written to '%s'.\n", fFilename.c_str());
+	}
+	else
+	{
+		fprintf(file, "Couldn't open '%s' for raw output.\n", fFilename.c_str());
+	}
+}
+
+HistogramObserver::HistogramObserver(double binWidth, int bins, const char * filename) :
+	fBinWidth(binWidth), fCounts(bins > 0 ? bins : 1, 0), fFilename(filename), fTotal(0), fPaths(0)
+{}
+
+HistogramObserver::~HistogramObserver()
+{}
+
+void HistogramObserver::Observe(const Bounce & bounce)
+{
+	//Starting state has no path before it.
+	if (bounce.fIndex == 0)
+		return;
+
+	int bin = (int)(bounce.fLength / fBinWidth);
+	if (bin >= (int) fCounts.size())
+		bin = fCounts.size() - 1;
+
+	fCounts[bin]++;
+	fTotal += bounce.fLength;
+	fPaths++;
+}
+
+void HistogramObserver::Finish(FILE * file)
+{
+	FILE * out = fopen(fFilename.c_str(), "w");
+
+	if (out)
+	{
+		fprintf(out, "%-24s%-12s%-24s\n", "l", "count", "density");
+
+		for (unsigned int b = 0; b != fCounts.size(); b++)
+			fprintf(out, "%-24.15f%-12li%-24.15f\n", (b + 0.5) * fBinWidth, fCounts[b],
+				fPaths > 0 ? fCounts[b] / (fPaths * fBinWidth) : 0);
+
+		fclose(out);
+	}
+
+	fprintf(file, "Mean free path: %f, histogram written to '%s'.\n", fPaths > 0 ? fTotal / fPaths : 0,
+		fFilename.c_str());
+}
+
+LyapunovObserver::LyapunovObserver(ITable & table, const Vector & position, const Vector & velocity, int interval) :
+	fSpectrum(&table, position, velocity), fInterval(interval > 0 ? interval : 1)
+{}
+
+LyapunovObserver::~LyapunovObserver()
+{}
+
+void LyapunovObserver::Observe(const Bounce & bounce)
+{
+	if (bounce.fIndex == 0)
+		return;
+
+	fSpectrum.Follow(bounce.fPosition, bounce.fIncoming, bounce.fVelocity, bounce.fLength / bounce.fIncoming.Mod());
+
+	if (bounce.fIndex % fInterval == 0)
+		fSpectrum.Orthonormalise();
+}
+
+void LyapunovObserver::Finish(FILE * file)
+{
+	fSpectrum.Orthonormalise();
+
+	fprintf(file, "Lyapunov exponents (per unit time): %f %f %f %f\n", fSpectrum.GetExponent(0),
+		fSpectrum.GetExponent(1), fSpectrum.GetExponent(2), fSpectrum.GetExponent(3));
+}
+
+BoxCountObserver::BoxCountObserver(ITable & table, int levels) :
+	fTable(&table), fCounter(levels, 0, 1, -1, 1)
+{}
+
+BoxCountObserver::~BoxCountObserver()
+{}
+
+void BoxCountObserver::Observe(const Bounce & bounce)
+{
+	if (bounce.fIndex == 0)
+		return;
+
+	double s, p;
+	BirkhoffCoordinates(*fTable, bounce.fPosition, bounce.fVelocity, s, p);
+
+	fCounter.Add(s / fTable->BoundaryLength(), p);
+}
+
+void BoxCountObserver::Finish(FILE * file)
+{
+	fprintf(file, "Box dimension of bounces (Birkhoff coordinates): %f\n",
+		fCounter.Dimension(1, fCounter.GetLevels()));
+}
+
+PoincareObserver::PoincareObserver(ITable & table, int width, int height, const char * filename) :
+	fTable(&table), fImage(width, height, 0, table.BoundaryLength(), -1, 1), fFilename(filename)
+{}
+
+PoincareObserver::~PoincareObserver()
+{}
+
+void PoincareObserver::Observe(const Bounce & bounce)
+{
+	if (bounce.fIndex == 0)
+		return;
+
+	double s, p;
+	BirkhoffCoordinates(*fTable, bounce.fPosition, bounce.fVelocity, s, p);
+
+	fImage.Add(s, p);
+}
+
+void PoincareObserver::Finish(FILE * file)
+{
+	fImage.WritePGM(fFilename.c_str());
+
+	fprintf(file, "Poincare section written to '%s'.\n", fFilename.c_str());
+}
+
+EscapeObserver::EscapeObserver(OpenTable & table) :
+	fTable(&table), fFirst(-1), fFirstTime(0), fHits(0), fBounces(0)
+{}
+
+EscapeObserver::~EscapeObserver()
+{}
+
+void EscapeObserver::Observe(const Bounce & bounce)
+{
+	if (bounce.fIndex == 0)
+		return;
+
+	fBounces++;
+
+	if (fTable->Escapes(bounce.fPosition))
+	{
+		if (fFirst < 0)
+		{
+			fFirst = bounce.fIndex;
+			fFirstTime = bounce.fTime;
+		}
+		fHits++;
+	}
+}
+
+void EscapeObserver::Finish(FILE * file)
+{
+	if (fFirst < 0)
+		fprintf(file, "No escape in %li bounces.\n", fBounces);
+	else
+		fprintf(file, "First escape at bounce %li (time %f); holes hit on %li of %li bounces.\n", fFirst,
+			fFirstTime, fHits, fBounces);
+}
+
+SymbolObserver::SymbolObserver(ITable & table, int maxLength, const char * itinerary, const char * filename) :
+	fTable(&table), fWriter(itinerary, table.ComponentCount()), fEntropy(table.ComponentCount(), maxLength),
+	fItinerary(itinerary), fFilename(filename)
+{}
+
+SymbolObserver::~SymbolObserver()
+{}
+
+void SymbolObserver::Observe(const Bounce & bounce)
+{
+	if (bounce.fIndex == 0)
+		return;
+
+	int symbol = fTable->Component(bounce.fPosition);
+
+	fWriter.Add(symbol);
+	fEntropy.Add(symbol);
+}
+
+void SymbolObserver::Finish(FILE * file)
+{
+	long bounces = fWriter.GetCount();
+	long bytes = fWriter.Close();
+
+	fprintf(file, "Itinerary of %li bounces written to '%s' (%i bits per bounce, %li bytes).\n", bounces,
+		fItinerary.c_str(), fWriter.GetBits(), bytes);
+
+	std::vector<long> words;
+	std::vector<double> block;
+	fEntropy.Entropies(words, block);
+	int reliable = fEntropy.Reliable(words);
+
+	if (fEntropy.GetDropped() > 0)
+		fprintf(file, "Words longer than %i bounces were dropped to keep the counts in memory.\n",
+			fEntropy.GetMaxLength());
+
+	FILE * out = fopen(fFilename.c_str(), "w");
+
+	if (out)
+	{
+		fprintf(out, "%-8s%-16s%-24s%-24s%-24s\n", "n", "words", "block", "rate", "top");
+
+		for (unsigned int n = 1; n <= words.size(); n++)
+		{
+			//Rates from one length to the next, in bits per bounce.
+			double rate = block[n - 1] - (n > 1 ? block[n - 2] : 0);
+			double top = words[n - 1] > 0 ? std::log2((double) words[n - 1] / (n > 1 ? words[n - 2] : 1)) : 0;
+
+			fprintf(out, "%-8i%-16li%-24.15f%-24.15f%-24.15f\n", n, words[n - 1], block[n - 1], rate, top);
+		}
+
+		fclose(out);
+	}
+
+	if (reliable < 2)
+	{
+		fprintf(file, "Too few bounces to estimate the entropies, block entropies written to '%s'.\n",
+			fFilename.c_str());
+		return;
+	}
+
+	//Estimates from the longest words seen often enough.
+	double metric = block[reliable - 1] - block[reliable - 2];
+	double top = std::log2((double) words[reliable - 1] / words[reliable - 2]);
+
+	fprintf(file, "Entropy from words of %i bounces: %f bits (%f nats) per bounce, topological %f bits.\n",
+		reliable, metric, metric * std::log(2.0), top);
+	fprintf(file, "Block entropies written to '%s'.\n", fFilename.c_str());
+}
+
+CorrelationObserver::CorrelationObserver(ITable & table, int maxLag, const char * filename) :
+	fTable(&table), fBlocks(maxLag > kDirectLag), fPath(fBlocks ? 1 : maxLag), fArc(fBlocks ? 1 : maxLag),
+	fBlockPath(fBlocks ? maxLag : 1), fBlockArc(fBlocks ? maxLag : 1), fFilename(filename)
+{}
+
+CorrelationObserver::~CorrelationObserver()
+{}
+
+void CorrelationObserver::Observe(const Bounce & bounce)
+{
+	if (bounce.fIndex == 0)
+		return;
+
+	double s, p;
+	BirkhoffCoordinates(*fTable, bounce.fPosition, bounce.fVelocity, s, p);
+
+	if (fBlocks)
+	{
+		fBlockPath.Add(bounce.fLength);
+		fBlockArc.Add(s);
+	}
+	else
+	{
+		fPath.Add(bounce.fLength);
+		fArc.Add(s);
+	}
+}
+
+void CorrelationObserver::Finish(FILE * file)
+{
+	std::vector<double> path, arc;
+
+	if (fBlocks)
+	{
+		fBlockPath.Correlations(path);
+		fBlockArc.Correlations(arc);
+	}
+	else
+	{
+		fPath.Correlations(path);
+		fArc.Correlations(arc);
+	}
+
+	FILE * out = fopen(fFilename.c_str(), "w");
+
+	if (out)
+	{
+		fprintf(out, "%-12s%-24s%-24s\n", "lag", "path", "s");
+
+		for (unsigned int k = 0; k != path.size(); k++)
+			fprintf(out, "%-12i%-24.15f%-24.15f\n", k, path[k], arc[k]);
+
+		fclose(out);
+	}
+
+	fprintf(file, "Correlation times: free path %f, arc length %f bounces (lags to %i, %s).\n", CorrelationTime(path),
+		CorrelationTime(arc), (int) path.size() - 1, fBlocks ? "FFT blocks" : "direct");
+	fprintf(file, "Correlations written to '%s'.\n", fFilename.c_str());
+}
+
+double CorrelationObserver::CorrelationTime(const std::vector<double> & correlation)
+{
+	double time = 1;
+
+	for (unsigned int k = 1; k < correlation.size() && k < 5 * time; k++)
+		time += 2 * correlation[k];
+
+	return time;
+}
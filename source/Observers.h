@@ -0,0 +1,284 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the observers which can be attached to a Pipeline.
+ */
+
+#ifndef _OBSERVERS_H
+#define _OBSERVERS_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "IObserver.h"
+#include "ITable.h"
+#include "OpenTable.h"
+#include "Lyapunov.h"
+#include "BoxCounter.h"
+#include "Raster.h"
+#include "Symbolic.h"
+#include "Correlation.h"
+
+/**
+ * Writes every record to a .dat file in the same format as the regular
+ * plots (InnerRun), so the usual plotting works on it.
+ */
+class RawObserver : public IObserver
+{
+public:
+	/**
+	 * Constructor, opening the output file and writing the header.
+	 *
+	 * ITable & table: table being run, for the angle of incidence.
+	 * char * filename: file to write to.
+	 */
+	RawObserver(ITable & table, const char * filename);
+	/**
+	 * Destructor, closes the file if Finish wasn't called.
+	 */
+	~RawObserver();
+
+	const char * Name() { return "raw output"; }
+	void Observe(const Bounce & bounce);
+	void Finish(FILE * file);
+
+private:
+	ITable * fTable;
+	std::string fFilename;
+	FILE * fFile;
+};
+
+/**
+ * Histogram of the path length between bounces (the free path), written
+ * with the mean free path.
+ */
+class HistogramObserver : public IObserver
+{
+public:
+	/**
+	 * Constructor for bins of width binWidth starting from 0. Longer paths
+	 * are counted in the last bin.
+	 *
+	 * double binWidth: width of each bin.
+	 * int bins: number of bins.
+	 * char * filename: file to write the histogram to.
+	 */
+	HistogramObserver(double binWidth, int bins, const char * filename);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~HistogramObserver();
+
+	const char * Name() { return "histogram"; }
+	void Observe(const Bounce & bounce);
+	void Finish(FILE * file);
+
+private:
+	double fBinWidth;
+	std::vector<long> fCounts;
+	std::string fFilename;
+	double fTotal;
+	long fPaths;
+};
+
+/**
+ * Lyapunov spectrum of the trajectory, carried along with tangent vectors
+ * as LyapunovSpectrum does.
+ */
+class LyapunovObserver : public IObserver
+{
+public:
+	/**
+	 * Constructor, for a trajectory starting at position and velocity.
+	 *
+	 * int interval: bounces between re-orthonormalisations.
+	 */
+	LyapunovObserver(ITable & table, const Vector & position, const Vector & velocity, int interval);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~LyapunovObserver();
+
+	const char * Name() { return "lyapunov"; }
+	void Observe(const Bounce & bounce);
+	void Finish(FILE * file);
+
+	// Getters.
+	const LyapunovSpectrum & GetSpectrum() const { return fSpectrum; }
+
+private:
+	LyapunovSpectrum fSpectrum;
+	int fInterval;
+};
+
+/**
+ * Box dimension of the bounces in Birkhoff coordinates, with s scaled to
+ * run from 0 to 1 (see BoxCounter).
+ */
+class BoxCountObserver : public IObserver
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * ITable & table: table being run.
+	 * int levels: finest box counting grid is 2^levels a side.
+	 */
+	BoxCountObserver(ITable & table, int levels);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~BoxCountObserver();
+
+	const char * Name() { return "box counting"; }
+	void Observe(const Bounce & bounce);
+	void Finish(FILE * file);
+
+private:
+	ITable * fTable;
+	BoxCounter fCounter;
+};
+
+/**
+ * Poincare section of the bounces in Birkhoff coordinates, drawn into a
+ * density image as the Poincare section mode does.
+ */
+class PoincareObserver : public IObserver
+{
+public:
+	/**
+	 * Constructor for an image of width x height pixels.
+	 *
+	 * char * filename: name of the .pgm file to write.
+	 */
+	PoincareObserver(ITable & table, int width, int height, const char * filename);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~PoincareObserver();
+
+	const char * Name() { return "poincare raster"; }
+	void Observe(const Bounce & bounce);
+	void Finish(FILE * file);
+
+private:
+	ITable * fTable;
+	Raster fImage;
+	std::string fFilename;
+};
+
+/**
+ * Watches for the ball reaching a hole in an open table. The ball carries on
+ * bouncing (the pipeline runs the closed table), so this gives the first
+ * escape time along with how often the holes are hit.
+ */
+class EscapeObserver : public IObserver
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * OpenTable & table: the table being run, with holes added.
+	 */
+	EscapeObserver(OpenTable & table);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~EscapeObserver();
+
+	const char * Name() { return "escape"; }
+	void Observe(const Bounce & bounce);
+	void Finish(FILE * file);
+
+private:
+	OpenTable * fTable;
+	long fFirst;
+	double fFirstTime;
+	long fHits;
+	long fBounces;
+};
+
+/**
+ * Symbolic dynamics of the trajectory: the wall hit at each bounce (see
+ * ITable::Component) is written to a packed binary itinerary (see
+ * SymbolWriter), and words of the itinerary are counted to estimate its
+ * block, metric and topological entropies (see BlockEntropy).
+ */
+class SymbolObserver : public IObserver
+{
+public:
+	/**
+	 * Constructor, opening the itinerary file.
+	 *
+	 * ITable & table: table being run.
+	 * int maxLength: longest words to count.
+	 * char * itinerary: binary file to write the itinerary to.
+	 * char * filename: file to write the entropy of each word length to.
+	 */
+	SymbolObserver(ITable & table, int maxLength, const char * itinerary, const char * filename);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~SymbolObserver();
+
+	const char * Name() { return "symbolic"; }
+	void Observe(const Bounce & bounce);
+	void Finish(FILE * file);
+
+private:
+	ITable * fTable;
+	SymbolWriter fWriter;
+	BlockEntropy fEntropy;
+	std::string fItinerary;
+	std::string fFilename;
+};
+
+/**
+ * Decay of correlations along the trajectory, of the free path and of the
+ * arc length s of each bounce, worked out as the bounces arrive. Lags up to
+ * kDirectLag are worked out directly (see Autocorrelation), which is
+ * cheaper for short lags; longer lags by FFT in blocks (see
+ * BlockAutocorrelation), which rounds the lag up to a power of 2.
+ */
+class CorrelationObserver : public IObserver
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * ITable & table: table being run.
+	 * int maxLag: largest lag in bounces.
+	 * char * filename: file to write the correlations to.
+	 */
+	CorrelationObserver(ITable & table, int maxLag, const char * filename);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~CorrelationObserver();
+
+	const char * Name() { return "correlation"; }
+	void Observe(const Bounce & bounce);
+	void Finish(FILE * file);
+
+	// Largest lag worked out directly, where the FFT starts to be cheaper.
+	static const int kDirectLag = 200;
+
+private:
+	/**
+	 * Integrated correlation time, 1 + 2 times the sum of the correlations
+	 * up to a window M. The window is the first with M >= 5 times the time
+	 * so far, which cuts off the noise in the tail without missing slow
+	 * decay (Sokal's automatic windowing).
+	 */
+	static double CorrelationTime(const std::vector<double> & correlation);
+
+	ITable * fTable;
+	bool fBlocks;
+	// Free path then arc length, only one pair is used.
+	Autocorrelation fPath, fArc;
+	BlockAutocorrelation fBlockPath, fBlockArc;
+	std::string fFilename;
+};
+
+#endif
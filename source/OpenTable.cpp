@@ -0,0 +1,94 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the OpenTable class.
+ */
+
+#include "OpenTable.h"
+
+OpenTable::OpenTable() :
+	fTable(0)
+{}
+
+OpenTable::OpenTable(ITable * table) :
+	fTable(table)
+{}
+
+OpenTable::~OpenTable()
+{}
+
+void OpenTable::AddHole(double start, double end)
+{
+	fHoleStart.push_back(start);
+	fHoleEnd.push_back(end);
+}
+
+bool OpenTable::Escapes(const Vector & collision)
+{
+	double s = fTable->BoundaryPosition(collision);
+
+	for (unsigned int i = 0; i != fHoleStart.size(); i++)
+	{
+		//Normal hole.
+		if (fHoleStart[i] <= fHoleEnd[i])
+		{
+			if (s >= fHoleStart[i] && s <= fHoleEnd[i])
+				return true;
+		}
+		//Hole wrapping round through 0.
+		else if (s >= fHoleStart[i] || s <= fHoleEnd[i])
+			return true;
+	}
+
+	return false;
+}
+
+double OpenTable::AngleIncidence(const Vector & collision, const Vector & velocity)
+{
+	return fTable->AngleIncidence(collision, velocity);
+}
+
+Vector OpenTable::ReflectVector(const Vector & collision, const Vector & velocity)
+{
+	return fTable->ReflectVector(collision, velocity);
+}
+
+Vector OpenTable::CollisionPoint(const Vector & initial, const Vector & velocity)
+{
+	return fTable->CollisionPoint(initial, velocity);
+}
+
+double OpenTable::BoundaryPosition(const Vector & collision)
+{
+	return fTable->BoundaryPosition(collision);
+}
+
+double OpenTable::BoundaryLength()
+{
+	return fTable->BoundaryLength();
+}
+
+Vector OpenTable::BoundaryPoint(double s)
+{
+	return fTable->BoundaryPoint(s);
+}
+
+Vector OpenTable::Normal(const Vector & collision)
+{
+	return fTable->Normal(collision);
+}
+
+int OpenTable::Component(const Vector & collision)
+{
+	return fTable->Component(collision);
+}
+
+int OpenTable::ComponentCount()
+{
+	return fTable->ComponentCount();
+}
+
+double OpenTable::Curvature(const Vector & collision)
+{
+	return fTable->Curvature(collision);
+}
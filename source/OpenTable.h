@@ -0,0 +1,82 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the OpenTable class.
+ */
+
+#ifndef _OPENTABLE_H
+#define _OPENTABLE_H
+
+#include <vector>
+
+#include "ITable.h"
+
+/**
+ * Open billiard table, wraps any other table and cuts one or more holes in
+ * its edge. Holes are given as ranges of the boundary coordinate of the
+ * wrapped table (see ITable::BoundaryPosition), so they can be an arc of a
+ * curved wall or a segment of a straight one.
+ *
+ * The table geometry is otherwise unchanged, all ITable calls are passed
+ * straight through. Whether a ball leaves is checked with Escapes().
+ */
+class OpenTable : public ITable
+{
+public:
+	/**
+	 * Empty constructor, wraps no table.
+	 */
+	OpenTable();
+	/**
+	 * Constructor wrapping table, which is not owned and must outlive this.
+	 */
+	OpenTable(ITable * table);
+	/**
+	 * Destructor, does not delete the wrapped table.
+	 */
+	~OpenTable();
+
+	// Getters and setters.
+	ITable * GetTable() const { return fTable; }
+	void SetTable(ITable * table) { fTable = table; }
+	int GetHoleCount() const { return fHoleStart.size(); }
+
+	/**
+	 * Adds a hole covering boundary coordinates from start to end. If start
+	 * is greater than end the hole wraps round through coordinate 0.
+	 *
+	 * double start: boundary coordinate the hole starts at.
+	 * double end: boundary coordinate the hole ends at.
+	 */
+	void AddHole(double start, double end);
+
+	/**
+	 * Checks whether a collision point lies in one of the holes.
+	 *
+	 * Vector & collision: point of collision with the wall of the table.
+	 * return: true if the ball leaves the table here.
+	 */
+	bool Escapes(const Vector & collision);
+
+	// Functions implemented from ITable, passed to the wrapped table.
+	double AngleIncidence(const Vector & collision, const Vector & velocity);
+	Vector ReflectVector(const Vector & collision, const Vector & velocity);
+	Vector CollisionPoint(const Vector & initial, const Vector & velocity);
+	double BoundaryPosition(const Vector & collision);
+	double BoundaryLength();
+	Vector BoundaryPoint(double s);
+	Vector Normal(const Vector & collision);
+	int Component(const Vector & collision);
+	int ComponentCount();
+	double Curvature(const Vector & collision);
+
+private:
+	// Wrapped table.
+	ITable * fTable;
+
+	// Hole ranges in boundary coordinates.
+	std::vector<double> fHoleStart;
+	std::vector<double> fHoleEnd;
+};
+
+#endif
@@ -0,0 +1,377 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the OrbitSearch and PeriodicOrbit classes.
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include "OrbitSearch.h"
+#include "Tangent.h"
+#include "Birkhoff.h"
+#include "Parallel.h"
+
+PeriodicOrbit::PeriodicOrbit() :
+	fPeriod(0), fAction(0), fTrace(0), fExponent(0), fFamily(1)
+{}
+
+PeriodicOrbit::~PeriodicOrbit()
+{}
+
+OrbitSearch::OrbitSearch(ITable & table, int period) :
+	fTable(&table), fLength(table.BoundaryLength()), fPeriod(period > 0 ? period : 1), fConverged(0)
+{
+	FindPieces();
+}
+
+OrbitSearch::~OrbitSearch()
+{}
+
+bool OrbitSearch::Map(double s, double p, int k, double & sk, double & pk, double jacobian[2][2], double & length)
+{
+	if (!(p > -1 && p < 1))
+		return false;
+
+	//Ball leaving the edge at s with unit speed, at angle p.
+	Vector position = fTable->BoundaryPoint(s);
+	Vector norm = fTable->Normal(position);
+	Vector tangent(norm.fY, -norm.fX);
+	double c = std::sqrt(1 - p * p);
+	double kappa = fTable->Curvature(position);
+	Vector velocity = tangent * p + norm * c;
+
+	//Tangent vectors for a change in s and in p. Moving along the edge
+	//turns the tangent and normal with the curvature.
+	Tangent ds(tangent, tangent * (-c * kappa) + norm * (p * kappa));
+	Tangent dp(Vector(0, 0), tangent - norm * (p / c));
+
+	length = 0;
+
+	for (int i = 0; i != k; i++)
+	{
+		Vector collision = fTable->CollisionPoint(position, velocity);
+		double time = (collision - position).Mod();
+
+		//Stuck in a corner.
+		if (!(time > 1e-12 * fLength))
+			return false;
+
+		ds.Flight(time);
+		dp.Flight(time);
+		ds.Bounce(*fTable, collision, velocity);
+		dp.Bounce(*fTable, collision, velocity);
+
+		velocity = fTable->ReflectVector(collision, velocity);
+		position = collision;
+		length += time;
+	}
+
+	BirkhoffCoordinates(*fTable, position, velocity, sk, pk);
+
+	if (!std::isfinite(sk) || !std::isfinite(pk) || !std::isfinite(length))
+		return false;
+
+	if (jacobian)
+	{
+		//Slide each perturbed ball along its path back onto the edge, then
+		//read off its change in s and p.
+		norm = fTable->Normal(position);
+		tangent = Vector(norm.fY, -norm.fX);
+		kappa = fTable->Curvature(position);
+
+		const Tangent * columns[2] = {&ds, &dp};
+		for (int j = 0; j != 2; j++)
+		{
+			Vector q = columns[j]->fQ - velocity * (norm.Dot(columns[j]->fQ) / norm.Dot(velocity));
+			double along = q.Dot(tangent);
+
+			jacobian[0][j] = along;
+			jacobian[1][j] = columns[j]->fV.Dot(tangent) + kappa * velocity.Dot(norm) * along;
+		}
+	}
+
+	return true;
+}
+
+bool OrbitSearch::Refine(double & s, double & p, double tolerance, int iterations)
+{
+	double sk, pk, length, jacobian[2][2];
+
+	for (int i = 0; i != iterations; i++)
+	{
+		if (!Map(s, p, fPeriod, sk, pk, jacobian, length))
+			return false;
+
+		//A fixed point comes back to the piece of edge it left.
+		if (Piece(sk) != Piece(s))
+			return false;
+
+		double fs = Wrap(sk, s);
+		double fp = pk - p;
+
+		if (std::abs(fs) < tolerance && std::abs(fp) < tolerance)
+			return true;
+
+		//Solve (J - I) d = -F.
+		double a = jacobian[0][0] - 1, b = jacobian[0][1];
+		double c = jacobian[1][0], d = jacobian[1][1] - 1;
+		double det = a * d - b * c;
+		double size = a * a + b * b + c * c + d * d;
+
+		if (!std::isfinite(det) || size == 0)
+			return false;
+
+		double stepS, stepP;
+
+		if (std::abs(det) > 1e-12 * size)
+		{
+			stepS = -(d * fs - b * fp) / det;
+			stepP = -(-c * fs + a * fp) / det;
+		}
+		else
+		{
+			//Parabolic orbits (e.g. in the rectangle, or the stadium's
+			//bouncing ball orbits) come in families along which J - I is
+			//singular. Take the smallest step which solves it in the least
+			//squares sense instead, from (A^T A + mu) d = -A^T F.
+			double mu = 1e-12 * size;
+			double aa = a * a + c * c + mu, ab = a * b + c * d, bb = b * b + d * d + mu;
+			double rs = -(a * fs + c * fp), rp = -(b * fs + d * fp);
+			double normal = aa * bb - ab * ab;
+
+			stepS = (bb * rs - ab * rp) / normal;
+			stepP = (aa * rp - ab * rs) / normal;
+		}
+
+		//Damp long steps, which have left the region where the map is
+		//close to linear.
+		double scale = std::max(std::abs(stepS) / (0.05 * fLength), std::abs(stepP) / 0.1);
+		if (scale > 1)
+		{
+			stepS /= scale;
+			stepP /= scale;
+		}
+
+		s = Move(s, stepS);
+		p += stepP;
+
+		if (!(p > -1 && p < 1))
+			return false;
+	}
+
+	return false;
+}
+
+void OrbitSearch::Search(const std::vector<double> & s, const std::vector<double> & p, double tolerance)
+{
+	int n = s.size();
+	std::vector<std::vector<PeriodicOrbit> > found(ThreadCount());
+	std::vector<long> converged(ThreadCount(), 0);
+
+	ParallelFor(n, [&](int begin, int end, int thread)
+	{
+		for (int i = begin; i != end; i++)
+		{
+			double si = s[i], pi = p[i];
+			PeriodicOrbit orbit;
+
+			if (Refine(si, pi, tolerance, 50) && Describe(si, pi, tolerance, orbit))
+			{
+				found[thread].push_back(orbit);
+				converged[thread]++;
+			}
+		}
+	});
+
+	//Keep each orbit once. Found in order of thread, then sorted so the
+	//output doesn't depend on the threads.
+	double same = std::max(1e3 * tolerance, 1e-7);
+
+	for (unsigned int t = 0; t != found.size(); t++)
+	{
+		fConverged += converged[t];
+
+		for (unsigned int i = 0; i != found[t].size(); i++)
+		{
+			unsigned int j = 0;
+			while (j != fOrbits.size() && !Same(fOrbits[j], found[t][i], same))
+				j++;
+
+			if (j == fOrbits.size())
+				fOrbits.push_back(found[t][i]);
+			else if (fOrbits[j].IsParabolic())
+				fOrbits[j].fFamily++;
+		}
+	}
+
+	std::sort(fOrbits.begin(), fOrbits.end(), [](const PeriodicOrbit & a, const PeriodicOrbit & b)
+	{
+		if (a.fPeriod != b.fPeriod)
+			return a.fPeriod < b.fPeriod;
+		if (a.fAction != b.fAction)
+			return a.fAction < b.fAction;
+		return a.fS[0] < b.fS[0];
+	});
+}
+
+bool OrbitSearch::Describe(double s, double p, double tolerance, PeriodicOrbit & orbit)
+{
+	//Bounces round the orbit.
+	std::vector<double> bounceS(1, s), bounceP(1, p);
+	double sk = s, pk = p, length;
+
+	for (int i = 1; i != fPeriod; i++)
+	{
+		if (!Map(sk, pk, 1, sk, pk, 0, length))
+			return false;
+		bounceS.push_back(sk);
+		bounceP.push_back(pk);
+	}
+
+	//Smallest period: the first bounce which comes back to the start, as
+	//long as it divides the search period.
+	int period = fPeriod;
+	for (int d = 1; d != fPeriod; d++)
+	{
+		if (fPeriod % d == 0 && std::abs(Wrap(bounceS[d], s)) < 1e3 * tolerance &&
+			std::abs(bounceP[d] - p) < 1e3 * tolerance)
+		{
+			period = d;
+			break;
+		}
+	}
+
+	//Start from the bounce with the smallest s.
+	int first = std::min_element(bounceS.begin(), bounceS.begin() + period) - bounceS.begin();
+
+	orbit.fPeriod = period;
+	orbit.fS.clear();
+	orbit.fP.clear();
+	for (int i = 0; i != period; i++)
+	{
+		orbit.fS.push_back(bounceS[(first + i) % period]);
+		orbit.fP.push_back(bounceP[(first + i) % period]);
+
+		//Grazing orbits and bounces off corners are artefacts of the edge,
+		//not real reflections.
+		if (std::abs(bounceP[i]) > 1 - 1e-6 || Corner(bounceS[i]))
+			return false;
+	}
+
+	double jacobian[2][2];
+	if (!Map(orbit.fS[0], orbit.fP[0], period, sk, pk, jacobian, orbit.fAction))
+		return false;
+
+	//Eigenvalues of an area preserving map multiply to 1, so the trace
+	//decides them.
+	orbit.fTrace = jacobian[0][0] + jacobian[1][1];
+	double t = std::abs(orbit.fTrace) / 2;
+	orbit.fExponent = t > 1 && !orbit.IsParabolic() ? std::log(t + std::sqrt(t * t - 1)) / period : 0;
+
+	return true;
+}
+
+bool OrbitSearch::Corner(double s)
+{
+	double step = 1e-7 * fLength;
+	Vector before = fTable->BoundaryPoint(Move(s, -step));
+	Vector after = fTable->BoundaryPoint(Move(s, step));
+
+	return (fTable->Normal(after) - fTable->Normal(before)).Mod() > 1e-3;
+}
+
+void OrbitSearch::FindPieces()
+{
+	fPieces.assign(1, 0);
+
+	//Walls are numbered in order of arc length, so the start of each is
+	//found by bisection.
+	double step = 1e-7 * fLength;
+	int walls = fTable->ComponentCount();
+
+	for (int w = 1; w < walls; w++)
+	{
+		double low = 0, high = fLength;
+		for (int i = 0; i != 100 && high - low > 1e-15 * fLength; i++)
+		{
+			double middle = (low + high) / 2;
+			if (fTable->Component(fTable->BoundaryPoint(middle)) < w)
+				low = middle;
+			else
+				high = middle;
+		}
+
+		//A wall which doesn't join the one before starts a new piece.
+		Vector before = fTable->BoundaryPoint(std::max(high - step, 0.0));
+		Vector after = fTable->BoundaryPoint(std::min(high + step, fLength));
+		if ((after - before).Mod() > 4 * step && high > fPieces.back())
+			fPieces.push_back(high);
+	}
+
+	fPieces.push_back(fLength);
+}
+
+int OrbitSearch::Piece(double s) const
+{
+	int i = std::upper_bound(fPieces.begin(), fPieces.end(), s) - fPieces.begin() - 1;
+	return std::min(std::max(i, 0), (int) fPieces.size() - 2);
+}
+
+double OrbitSearch::Move(double s, double ds) const
+{
+	int i = Piece(s);
+	double start = fPieces[i], length = fPieces[i + 1] - start;
+
+	double t = std::fmod(s - start + ds, length);
+	if (t < 0)
+		t += length;
+
+	//Rounding can land exactly on the end, which is the start.
+	return t < length ? start + t : start;
+}
+
+bool OrbitSearch::Same(const PeriodicOrbit & a, const PeriodicOrbit & b, double tolerance) const
+{
+	if (a.fPeriod != b.fPeriod)
+		return false;
+
+	//Same orbit if the first bounce of b is any bounce of a, which also
+	//catches orbits started either side of s = 0.
+	for (int i = 0; i != a.fPeriod; i++)
+	{
+		if (std::abs(Wrap(a.fS[i], b.fS[0])) < tolerance && std::abs(a.fP[i] - b.fP[0]) < tolerance)
+			return true;
+	}
+
+	if (!a.IsParabolic() || !b.IsParabolic() || std::abs(a.fAction - b.fAction) > tolerance)
+		return false;
+
+	//Members of a family slide along the edge together, keeping their angles.
+	std::vector<double> pa(a.fP), pb(b.fP);
+	std::sort(pa.begin(), pa.end());
+	std::sort(pb.begin(), pb.end());
+
+	for (int i = 0; i != a.fPeriod; i++)
+	{
+		if (std::abs(pa[i] - pb[i]) > tolerance)
+			return false;
+	}
+
+	return true;
+}
+
+double OrbitSearch::Wrap(double a, double b) const
+{
+	int i = Piece(a);
+	if (Piece(b) != i)
+		return fLength;
+
+	double length = fPieces[i + 1] - fPieces[i];
+	double ds = std::fmod(a - b, length);
+	if (ds >= length / 2)
+		ds -= length;
+	else if (ds < -length / 2)
+		ds += length;
+	return ds;
+}
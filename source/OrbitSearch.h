@@ -0,0 +1,177 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the OrbitSearch and PeriodicOrbit classes.
+ */
+
+#ifndef _ORBITSEARCH_H
+#define _ORBITSEARCH_H
+
+#include <vector>
+#include <cmath>
+
+#include "ITable.h"
+
+/**
+ * A periodic orbit of the bounce map, as found by OrbitSearch.
+ */
+class PeriodicOrbit
+{
+public:
+	/**
+	 * Empty constructor, no bounces.
+	 */
+	PeriodicOrbit();
+	/**
+	 * Destructor, does nothing.
+	 */
+	~PeriodicOrbit();
+
+	// Smallest period in bounces.
+	int fPeriod;
+	// Birkhoff coordinates of each bounce, starting from the one with the
+	// smallest s.
+	std::vector<double> fS;
+	std::vector<double> fP;
+	// Length of the orbit, which is its action at unit speed.
+	double fAction;
+	// Trace of the monodromy matrix (the linearised map round the orbit).
+	// The orbit is stable (elliptic) for |trace| < 2 and unstable
+	// (hyperbolic) for |trace| > 2.
+	double fTrace;
+	// Growth rate per bounce of the unstable direction, ln|largest
+	// eigenvalue| / period, 0 for stable orbits.
+	double fExponent;
+	// Parabolic orbits (|trace| = 2) come in continuous families, e.g. the
+	// bouncing ball orbits of the stadium; this counts the members found,
+	// and is 1 for isolated orbits.
+	int fFamily;
+
+	/**
+	 * Whether the trace is 2 or -2, to rounding.
+	 */
+	bool IsParabolic() const { return std::abs(std::abs(fTrace) - 2) < 1e-6; }
+};
+
+/**
+ * Finds periodic orbits of the bounce map in Birkhoff coordinates (see
+ * BirkhoffCoordinates) with Newton's method. Each guess (s, p) is mapped
+ * through k bounces, and the 2x2 Jacobian of the k-fold map is carried
+ * along with tangent vectors (see Tangent) so that each Newton step solves
+ * T^k(s, p) = (s, p) to first order.
+ *
+ * Converged orbits are cut down to their smallest period, started from
+ * their bounce with the smallest s, and kept only if they haven't been
+ * found already from another guess. Members of one parabolic family are
+ * kept as a single orbit. Guesses are refined in parallel.
+ */
+class OrbitSearch
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * ITable & table: table to search.
+	 * int period: number of bounces k of the map to find fixed points of.
+	 * Orbits whose period divides k are found as well.
+	 */
+	OrbitSearch(ITable & table, int period);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~OrbitSearch();
+
+	// Getters.
+	int GetPeriod() const { return fPeriod; }
+	int GetOrbitCount() const { return fOrbits.size(); }
+	const PeriodicOrbit & GetOrbit(int i) const { return fOrbits[i]; }
+	long GetConverged() const { return fConverged; }
+
+	/**
+	 * Maps a bounce through k bounces.
+	 *
+	 * double s, p: Birkhoff coordinates of the starting bounce.
+	 * int k: number of bounces.
+	 * double & sk, & pk: set to the coordinates after k bounces.
+	 * double jacobian[2][2]: set to d(sk, pk)/d(s, p), or 0 to skip it.
+	 * double & length: set to the path length travelled.
+	 * return: false if the ball left the table or the numbers broke down.
+	 */
+	bool Map(double s, double p, int k, double & sk, double & pk, double jacobian[2][2], double & length);
+
+	/**
+	 * Refines a guess with damped Newton steps.
+	 *
+	 * double & s, & p: guess, set to the fixed point if found.
+	 * double tolerance: largest acceptable |T^k(s, p) - (s, p)|.
+	 * int iterations: most Newton steps to take.
+	 * return: true if the guess converged.
+	 */
+	bool Refine(double & s, double & p, double tolerance, int iterations);
+
+	/**
+	 * Refines every guess in parallel and keeps the distinct orbits found.
+	 *
+	 * std::vector<double> & s, & p: Birkhoff coordinates of the guesses.
+	 * double tolerance: as for Refine.
+	 */
+	void Search(const std::vector<double> & s, const std::vector<double> & p, double tolerance);
+
+private:
+	/**
+	 * Fills in an orbit through a fixed point: its smallest period, bounces,
+	 * action and stability.
+	 *
+	 * return: false if the orbit grazes the edge or the map fails.
+	 */
+	bool Describe(double s, double p, double tolerance, PeriodicOrbit & orbit);
+
+	/**
+	 * Whether two orbits are the same, or from the same parabolic family:
+	 * same period and length, bouncing at the same angles.
+	 */
+	bool Same(const PeriodicOrbit & a, const PeriodicOrbit & b, double tolerance) const;
+
+	/**
+	 * Whether the edge has a corner at s, where the normal jumps. Joins where
+	 * only the curvature jumps (e.g. the stadium) are smooth enough to bounce
+	 * off. Only the piece of edge holding s is looked at, so the jump in s
+	 * from the outer walls of the Lorentz table to its scatterer isn't one.
+	 */
+	bool Corner(double s);
+
+	/**
+	 * Finds the closed pieces of the edge (see fPieces), from where the walls
+	 * (see ITable::Component) start and whether each joins the one before.
+	 */
+	void FindPieces();
+
+	/**
+	 * Index of the closed piece of edge holding arc length s.
+	 */
+	int Piece(double s) const;
+
+	/**
+	 * Moves arc length s by ds round its own piece of edge.
+	 */
+	double Move(double s, double ds) const;
+
+	/**
+	 * Difference a - b of two arc lengths, wrapped round their piece of edge
+	 * into [-L/2, L/2) for that piece's length L. Arc lengths on different
+	 * pieces are never close, so for them this is the whole edge length.
+	 */
+	double Wrap(double a, double b) const;
+
+	ITable * fTable;
+	double fLength;
+	// Arc length at the start of each closed piece of the edge, and then
+	// fLength: one piece for most tables, but the outer walls and the
+	// scatterer for the Lorentz table.
+	std::vector<double> fPieces;
+	int fPeriod;
+	std::vector<PeriodicOrbit> fOrbits;
+	long fConverged;
+};
+
+#endif
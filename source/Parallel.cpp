@@ -0,0 +1,69 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the parallel helper functions.
+ */
+
+#include <cstdlib>
+#include <thread>
+#include <algorithm>
+
+#include "Parallel.h"
+#include "Scheduler.h"
+
+int ThreadCount()
+{
+	//Environment variable takes precedence.
+	const char * env = std::getenv("BILLIARDS_THREADS");
+	if (env && std::atoi(env) > 0)
+		return std::atoi(env);
+
+	int threads = std::thread::hardware_concurrency();
+
+	//hardware_concurrency may return 0 if it can't tell.
+	return threads > 0 ? threads : 1;
+}
+
+void ParallelFor(int n, const std::function<void(int begin, int end, int thread)> & body)
+{
+	Scheduler::Global().Run(n, body);
+}
+
+void ParallelPrefixSum(std::vector<double> & values)
+{
+	int n = values.size();
+	int blocks = std::min(ThreadCount(), n);
+	if (blocks < 1)
+		return;
+
+	int size = (n + blocks - 1) / blocks;
+	std::vector<double> totals(blocks + 1, 0);
+
+	//Sums within each block.
+	ParallelFor(blocks, [&](int begin, int end, int thread)
+	{
+		for (int b = begin; b != end; b++)
+		{
+			double sum = 0;
+			for (int i = b * size; i < std::min(n, (b + 1) * size); i++)
+			{
+				sum += values[i];
+				values[i] = sum;
+			}
+			totals[b + 1] = sum;
+		}
+	});
+
+	for (int b = 1; b <= blocks; b++)
+		totals[b] += totals[b - 1];
+
+	//Totals of the blocks before.
+	ParallelFor(blocks, [&](int begin, int end, int thread)
+	{
+		for (int b = begin; b != end; b++)
+		{
+			for (int i = b * size; i < std::min(n, (b + 1) * size); i++)
+				values[i] += totals[b];
+		}
+	});
+}
@@ -0,0 +1,47 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the parallel helper functions.
+ */
+
+#ifndef _PARALLEL_H
+#define _PARALLEL_H
+
+#include <functional>
+#include <vector>
+
+/**
+ * Number of worker threads used by the parallel simulation modes. This is the
+ * hardware concurrency, unless overridden by the BILLIARDS_THREADS
+ * environment variable.
+ *
+ * return: number of threads, always at least 1.
+ */
+int ThreadCount();
+
+/**
+ * Splits the range [0, n) into pieces and calls body(begin, end, thread) for
+ * each piece in parallel, on the shared work-stealing Scheduler. Returns once
+ * every piece is finished. A thread may be given several pieces, which need
+ * not be next to each other.
+ *
+ * The thread index runs from 0 to ThreadCount() - 1, and is intended for
+ * indexing per-thread accumulators which are reduced afterwards.
+ *
+ * int n: size of the range to split.
+ * body: function to call on each block.
+ */
+void ParallelFor(int n, const std::function<void(int begin, int end, int thread)> & body);
+
+/**
+ * Replaces each value by the sum of it and every value before it (an
+ * inclusive prefix sum), in parallel. The values are cut into one block per
+ * thread; each block is summed in parallel, the block totals are summed in
+ * order, and then each block adds the total of those before it, again in
+ * parallel.
+ *
+ * std::vector<double> & values: values to sum.
+ */
+void ParallelPrefixSum(std::vector<double> & values);
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the PhaseEntropy class.
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include "PhaseEntropy.h"
+
+PhaseEntropy::PhaseEntropy(double x, double y, int cells, int angles, int threads) :
+	fX(x), fY(y), fCells(cells > 0 ? cells : 1), fAngles(angles > 0 ? angles : 1),
+	fCounts(threads > 0 ? threads : 1, std::vector<long>(GetCells(), 0))
+{}
+
+PhaseEntropy::~PhaseEntropy()
+{}
+
+void PhaseEntropy::Add(const Vector & position, const Vector & velocity, int thread)
+{
+	int i = (int)((position.fX + fX) / (2 * fX) * fCells);
+	int j = (int)((position.fY + fY) / (2 * fY) * fCells);
+	int k = (int)((std::atan2(velocity.fY, velocity.fX) / (2 * M_PI) + 0.5) * fAngles);
+
+	i = std::min(std::max(i, 0), fCells - 1);
+	j = std::min(std::max(j, 0), fCells - 1);
+	k = std::min(std::max(k, 0), fAngles - 1);
+
+	fCounts[thread][(k * fCells + j) * fCells + i]++;
+}
+
+double PhaseEntropy::Entropy(int & occupied)
+{
+	std::vector<long> & total = fCounts[0];
+
+	for (unsigned int t = 1; t != fCounts.size(); t++)
+	{
+		for (unsigned int c = 0; c != total.size(); c++)
+		{
+			total[c] += fCounts[t][c];
+			fCounts[t][c] = 0;
+		}
+	}
+
+	long balls = 0;
+	for (unsigned int c = 0; c != total.size(); c++)
+		balls += total[c];
+
+	double entropy = 0;
+	occupied = 0;
+
+	for (unsigned int c = 0; c != total.size(); c++)
+	{
+		if (total[c] > 0)
+		{
+			double p = (double) total[c] / balls;
+			entropy -= p * std::log(p);
+			occupied++;
+		}
+		total[c] = 0;
+	}
+
+	return entropy;
+}
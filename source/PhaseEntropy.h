@@ -0,0 +1,72 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the PhaseEntropy class.
+ */
+
+#ifndef _PHASEENTROPY_H
+#define _PHASEENTROPY_H
+
+#include <vector>
+
+#include "Vector.h"
+
+/**
+ * Coarse grained entropy of an ensemble of balls in phase space. Phase
+ * space (position and direction of the velocity) is cut into a grid of
+ * cells, the balls are counted into the cells, and the entropy is
+ * -sum p ln p over the fraction p of the balls in each cell. It starts low
+ * for balls bunched together and grows towards ln(cells reached) as the
+ * table mixes them.
+ *
+ * Each thread counts into its own copy of the grid, so balls can be added
+ * from a ParallelFor; the copies are added together by Entropy.
+ */
+class PhaseEntropy
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * double x, y: the table lies within -x to x and -y to y.
+	 * int cells: cells across each of x and y.
+	 * int angles: cells in the direction of the velocity.
+	 * int threads: number of threads adding balls.
+	 */
+	PhaseEntropy(double x, double y, int cells, int angles, int threads);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~PhaseEntropy();
+
+	// Getters.
+	int GetCells() const { return fCells * fCells * fAngles; }
+
+	/**
+	 * Counts a ball.
+	 *
+	 * Vector & position, & velocity: state of the ball.
+	 * int thread: thread adding it.
+	 */
+	void Add(const Vector & position, const Vector & velocity, int thread);
+
+	/**
+	 * Entropy of the balls counted since the last call, which are then
+	 * forgotten.
+	 *
+	 * int & occupied: set to the number of cells with a ball in.
+	 * return: entropy in nats.
+	 */
+	double Entropy(int & occupied);
+
+private:
+	double fX;
+	double fY;
+	int fCells;
+	int fAngles;
+
+	// Counts for each thread.
+	std::vector<std::vector<long> > fCounts;
+};
+
+#endif
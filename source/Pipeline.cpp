@@ -0,0 +1,85 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the Pipeline class.
+ */
+
+#include <chrono>
+#include <algorithm>
+
+#include "Pipeline.h"
+
+Pipeline::Pipeline() :
+	fSimulation(0), fRecords(0)
+{}
+
+Pipeline::~Pipeline()
+{}
+
+void Pipeline::Attach(IObserver * observer)
+{
+	fObservers.push_back(observer);
+	fCost.push_back(0);
+}
+
+void Pipeline::Run(Trajectory & trajectory, long n)
+{
+	//Records per block handed out.
+	const long block = 4096;
+
+	std::vector<Bounce> records(block);
+	std::chrono::steady_clock::time_point start;
+
+	for (long done = 0; done < n + 1; done += block)
+	{
+		long m = std::min(block, n + 1 - done);
+
+		start = std::chrono::steady_clock::now();
+		bool more = true;
+		for (long k = 0; k != m && more; k++)
+		{
+			more = trajectory.Next(records[k]);
+			if (!more)
+				m = k;
+		}
+		fSimulation += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		for (unsigned int o = 0; o != fObservers.size(); o++)
+		{
+			start = std::chrono::steady_clock::now();
+			for (long k = 0; k != m; k++)
+				fObservers[o]->Observe(records[k]);
+			fCost[o] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		fRecords += m;
+
+		//Trajectory stopped by its health monitor.
+		if (!more)
+			break;
+	}
+}
+
+void Pipeline::Finish(FILE * file)
+{
+	for (unsigned int o = 0; o != fObservers.size(); o++)
+		fObservers[o]->Finish(file);
+}
+
+void Pipeline::WriteCosts(FILE * file) const
+{
+	double total = fSimulation;
+	for (unsigned int o = 0; o != fCost.size(); o++)
+		total += fCost[o];
+
+	if (total <= 0)
+		total = 1;
+
+	fprintf(file, "%-20s%-16s%-16s%-10s\n", "stage", "time (s)", "ns / record", "share");
+	fprintf(file, "%-20s%-16.4f%-16.1f%-10.1f\n", "simulation", fSimulation,
+		fRecords > 0 ? 1e9 * fSimulation / fRecords : 0, 100 * fSimulation / total);
+
+	for (unsigned int o = 0; o != fObservers.size(); o++)
+		fprintf(file, "%-20s%-16.4f%-16.1f%-10.1f\n", fObservers[o]->Name(), fCost[o],
+			fRecords > 0 ? 1e9 * fCost[o] / fRecords : 0, 100 * fCost[o] / total);
+}
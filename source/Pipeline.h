@@ -0,0 +1,74 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the Pipeline class.
+ */
+
+#ifndef _PIPELINE_H
+#define _PIPELINE_H
+
+#include <cstdio>
+#include <vector>
+
+#include "IObserver.h"
+#include "Trajectory.h"
+
+/**
+ * Runs one trajectory and hands every record to several observers, so each
+ * bounce is only worked out once however many analyses want it. Records
+ * are pulled in blocks, and each observer works through the whole block in
+ * turn; this keeps each observer's data in cache and lets the time spent in
+ * each observer, and in the simulation itself, be measured cheaply.
+ */
+class Pipeline
+{
+public:
+	/**
+	 * Constructor, no observers.
+	 */
+	Pipeline();
+	/**
+	 * Destructor, does not delete the observers.
+	 */
+	~Pipeline();
+
+	/**
+	 * Adds an observer. Observers are called in the order they are added,
+	 * and must outlive the pipeline.
+	 */
+	void Attach(IObserver * observer);
+
+	/**
+	 * Pulls the starting state and n bounces from trajectory, handing each
+	 * to every observer. Stops early if the trajectory ends (see
+	 * Trajectory::SetMonitor).
+	 *
+	 * Trajectory & trajectory: trajectory to run.
+	 * long n: number of bounces.
+	 */
+	void Run(Trajectory & trajectory, long n);
+
+	/**
+	 * Calls Finish on every observer.
+	 *
+	 * FILE * file: stream for the observers' summaries.
+	 */
+	void Finish(FILE * file);
+
+	/**
+	 * Writes the time taken by the simulation and by each observer.
+	 *
+	 * FILE * file: stream to write to.
+	 */
+	void WriteCosts(FILE * file) const;
+
+private:
+	std::vector<IObserver *> fObservers;
+
+	// Seconds spent in each observer, and pulling records.
+	std::vector<double> fCost;
+	double fSimulation;
+	long fRecords;
+};
+
+#endif
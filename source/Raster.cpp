@@ -0,0 +1,137 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the Raster class.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+
+#include "Raster.h"
+
+Raster::Raster() :
+	fWidth(0), fHeight(0), fXMin(0), fXMax(0), fYMin(0), fYMax(0), fXScale(0), fYScale(0)
+{}
+
+Raster::Raster(int width, int height, double xMin, double xMax, double yMin, double yMax) :
+	fWidth(width), fHeight(height), fXMin(xMin), fXMax(xMax), fYMin(yMin), fYMax(yMax),
+	fXScale(width / (xMax - xMin)), fYScale(height / (yMax - yMin)), fPixels(width * height, 0)
+{}
+
+Raster::~Raster()
+{}
+
+void Raster::Merge(const Raster & other)
+{
+	for (unsigned int i = 0; i != fPixels.size() && i != other.fPixels.size(); i++)
+		fPixels[i] += other.fPixels[i];
+}
+
+void Raster::Clear()
+{
+	std::fill(fPixels.begin(), fPixels.end(), 0);
+}
+
+Raster Raster::Downsample() const
+{
+	Raster half(fWidth / 2, fHeight / 2, fXMin, fXMax, fYMin, fYMax);
+
+	for (int j = 0; j != half.fHeight; j++)
+		for (int i = 0; i != half.fWidth; i++)
+			half.fPixels[j * half.fWidth + i] = GetPixel(2*i, 2*j) + GetPixel(2*i + 1, 2*j)
+				+ GetPixel(2*i, 2*j + 1) + GetPixel(2*i + 1, 2*j + 1);
+
+	return half;
+}
+
+Raster Raster::Crop(int i, int j, int width, int height) const
+{
+	//Area covered by the block, remembering row 0 is the top.
+	Raster crop(width, height, fXMin + i / fXScale, fXMin + (i + width) / fXScale,
+		fYMax - (j + height) / fYScale, fYMax - j / fYScale);
+
+	for (int y = 0; y != height; y++)
+		for (int x = 0; x != width; x++)
+			crop.fPixels[y * width + x] = GetPixel(i + x, j + y);
+
+	return crop;
+}
+
+double Raster::Max() const
+{
+	if (fPixels.empty())
+		return 0;
+
+	return *std::max_element(fPixels.begin(), fPixels.end());
+}
+
+double Raster::Quantile(double fraction) const
+{
+	std::vector<double> full;
+
+	for (unsigned int i = 0; i != fPixels.size(); i++)
+		if (fPixels[i] > 0)
+			full.push_back(fPixels[i]);
+
+	if (full.empty())
+		return 0;
+
+	unsigned int k = (unsigned int)(fraction * (full.size() - 1));
+	std::nth_element(full.begin(), full.begin() + k, full.end());
+
+	return full[k];
+}
+
+bool Raster::WritePGM(const char * filename, double white) const
+{
+	return WriteScaledPGM(filename, white < 1 ? Quantile(white) : Max());
+}
+
+bool Raster::WriteScaledPGM(const char * filename, double level) const
+{
+	FILE * file = fopen(filename, "wb");
+	if (!file)
+		return false;
+
+	fprintf(file, "P5\n%i %i\n255\n", fWidth, fHeight);
+
+	//Log tone mapping, empty pixels are black and the white level and
+	//above are white.
+	double scale = std::log(1 + level);
+	std::vector<unsigned char> row(fWidth);
+
+	for (int j = 0; j != fHeight; j++)
+	{
+		for (int i = 0; i != fWidth; i++)
+		{
+			double value = scale > 0 ? std::log(1 + GetPixel(i, j)) / scale : 0;
+			row[i] = (unsigned char)(255 * std::min(value, 1.0) + 0.5);
+		}
+		fwrite(&row[0], 1, fWidth, file);
+	}
+
+	fclose(file);
+
+	return true;
+}
+
+bool Raster::WriteRaw(const char * filename) const
+{
+	FILE * file = fopen(filename, "wb");
+	if (!file)
+		return false;
+
+	std::vector<float> row(fWidth);
+
+	for (int j = 0; j != fHeight; j++)
+	{
+		for (int i = 0; i != fWidth; i++)
+			row[i] = (float)GetPixel(i, j);
+		fwrite(&row[0], sizeof(float), fWidth, file);
+	}
+
+	fclose(file);
+
+	return true;
+}
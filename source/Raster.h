@@ -0,0 +1,202 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the Raster class.
+ */
+
+#ifndef _RASTER_H
+#define _RASTER_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Two dimensional density raster. Points are binned into a grid of pixels
+ * covering a rectangle, so that millions of points can be turned into an
+ * image without writing them to a text file first.
+ *
+ * Add is not thread safe. To fill one raster from several threads use a
+ * SharedRaster, rather than a full copy per thread.
+ */
+class Raster
+{
+public:
+	/**
+	 * Empty constructor, raster has no pixels.
+	 */
+	Raster();
+	/**
+	 * Constructor for a width x height raster covering x from xMin to xMax
+	 * and y from yMin to yMax.
+	 */
+	Raster(int width, int height, double xMin, double xMax, double yMin, double yMax);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~Raster();
+
+	// Getters.
+	int GetWidth() const { return fWidth; }
+	int GetHeight() const { return fHeight; }
+	double GetXMin() const { return fXMin; }
+	double GetXMax() const { return fXMax; }
+	double GetYMin() const { return fYMin; }
+	double GetYMax() const { return fYMax; }
+	double GetPixel(int i, int j) const { return fPixels[j * fWidth + i]; }
+	void SetPixel(int i, int j, double value) { fPixels[j * fWidth + i] = value; }
+
+	/**
+	 * Adds one to the pixel containing (x, y). Points outside the raster are
+	 * ignored.
+	 */
+	void Add(double x, double y)
+	{
+		int index = Index(x, y);
+		if (index >= 0)
+			fPixels[index] += 1;
+	}
+
+	/**
+	 * Index of the pixel containing (x, y), counting row by row from the top
+	 * left.
+	 *
+	 * return: pixel index, or -1 if the point is outside the raster.
+	 */
+	int Index(double x, double y) const
+	{
+		//Written so NaNs fail the test too.
+		if (x >= fXMin && x < fXMax && y > fYMin && y <= fYMax)
+		{
+			int i = std::min((int)((x - fXMin) * fXScale), fWidth - 1);
+			int j = std::min((int)((fYMax - y) * fYScale), fHeight - 1);
+			return j * fWidth + i;
+		}
+
+		return -1;
+	}
+
+	/**
+	 * Adds value to the pixel with the given index, from Index.
+	 */
+	void AddIndex(int index, double value) { fPixels[index] += value; }
+
+	/**
+	 * Adds a line segment from (x0, y0) to (x1, y1), one sample per pixel
+	 * along its length, so that pixel values are proportional to the length
+	 * of path crossing them.
+	 */
+	void AddLine(double x0, double y0, double x1, double y1)
+	{
+		Sample(x0, y0, x1, y1, [this](double x, double y) { Add(x, y); });
+	}
+
+	/**
+	 * Calls add(x, y) at the points AddLine would add, so the same line can
+	 * be drawn somewhere other than straight into the pixels.
+	 */
+	template <typename Visit>
+	void Sample(double x0, double y0, double x1, double y1, Visit add) const
+	{
+		//Length in pixels along the longer axis.
+		double steps = std::max(std::abs(x1 - x0) * fXScale, std::abs(y1 - y0) * fYScale);
+
+		//Guard against NaNs and lines miles off the raster.
+		if (!(steps < 1e7))
+			return;
+
+		int n = (int)steps + 1;
+		double dx = (x1 - x0) / n, dy = (y1 - y0) / n;
+
+		//Start half a step in so joined segments don't double count corners.
+		for (int k = 0; k != n; k++)
+			add(x0 + (k + 0.5) * dx, y0 + (k + 0.5) * dy);
+	}
+
+	/**
+	 * Adds the pixels of other, which must be the same size.
+	 */
+	void Merge(const Raster & other);
+
+	/**
+	 * Sets every pixel to zero.
+	 */
+	void Clear();
+
+	/**
+	 * Half resolution copy covering the same area, each pixel being the sum
+	 * of a 2x2 block. Width and height should be even.
+	 */
+	Raster Downsample() const;
+
+	/**
+	 * Copy of a width x height block of pixels starting at pixel (i, j),
+	 * covering the matching part of this raster's area.
+	 */
+	Raster Crop(int i, int j, int width, int height) const;
+
+	/**
+	 * Largest pixel value.
+	 */
+	double Max() const;
+
+	/**
+	 * Pixel value below which a fraction of the non-empty pixels lie.
+	 *
+	 * double fraction: quantile to find, between 0 and 1.
+	 * return: pixel value at that quantile (0 if the raster is empty).
+	 */
+	double Quantile(double fraction) const;
+
+	/**
+	 * Writes an 8 bit binary PGM image, with pixel values log scaled so both
+	 * sparse and dense regions show up. Row 0 is the top of the image
+	 * (y = yMax).
+	 *
+	 * Pixels at or above the white point are saturated. This is the
+	 * Quantile(white) of the non-empty pixels, so a few very dense pixels
+	 * (like the start point of every fractal ray) don't push everything
+	 * else down to black.
+	 *
+	 * char * filename: name of file to write.
+	 * double white: quantile used as the white point, 1 for the maximum.
+	 * return: false if the file could not be written.
+	 */
+	bool WritePGM(const char * filename, double white = 1) const;
+
+	/**
+	 * As WritePGM, but with the white point given as a pixel value rather
+	 * than a quantile. Use this to tone map several images the same way.
+	 *
+	 * char * filename: name of file to write.
+	 * double level: pixel value which is drawn white.
+	 * return: false if the file could not be written.
+	 */
+	bool WriteScaledPGM(const char * filename, double level) const;
+
+	/**
+	 * Writes the raw pixel values as 32 bit floats, row by row from the top
+	 * of the image, with no header.
+	 *
+	 * char * filename: name of file to write.
+	 * return: false if the file could not be written.
+	 */
+	bool WriteRaw(const char * filename) const;
+
+private:
+	int fWidth;
+	int fHeight;
+	double fXMin;
+	double fXMax;
+	double fYMin;
+	double fYMax;
+
+	// Pixels per unit length, cached for Add.
+	double fXScale;
+	double fYScale;
+
+	// Pixel values, row major from the top row.
+	std::vector<double> fPixels;
+};
+
+#endif
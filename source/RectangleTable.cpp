@@ -154,3 +154,75 @@ Vector RectangleTable::CollisionPoint(const Vector & initial, const Vector & vel
 	}
 	return Vector(0,0);
 }
+
+double RectangleTable::BoundaryPosition(const Vector & collision)
+{
+	switch (Component(collision))
+	{
+		case 0:
+			return collision.fY + fY;
+		case 1:
+			return 2*fY + (fX - collision.fX);
+		case 2:
+			return 2*fY + 2*fX + (fY - collision.fY);
+	}
+
+	return 4*fY + 2*fX + (collision.fX + fX);
+}
+
+double RectangleTable::BoundaryLength()
+{
+	return 4*fX + 4*fY;
+}
+
+Vector RectangleTable::BoundaryPoint(double s)
+{
+	//Same order as BoundaryPosition: right, top, left, bottom.
+	if (s < 2*fY)
+		return Vector(fX, s - fY);
+	s -= 2*fY;
+
+	if (s < 2*fX)
+		return Vector(fX - s, fY);
+	s -= 2*fX;
+
+	if (s < 2*fY)
+		return Vector(-fX, fY - s);
+	s -= 2*fY;
+
+	return Vector(-fX + s, -fY);
+}
+
+Vector RectangleTable::Normal(const Vector & collision)
+{
+	switch (Component(collision))
+	{
+		case 0:
+			return Vector(-1, 0);
+		case 1:
+			return Vector(0, -1);
+		case 2:
+			return Vector(1, 0);
+	}
+
+	return Vector(0, 1);
+}
+
+int RectangleTable::Component(const Vector & collision)
+{
+	// Distance to each wall, the point is taken to lie on the closest.
+	// (Cheaper and safer than the exact comparisons used above.)
+	double right = fX - collision.fX;
+	double top = fY - collision.fY;
+	double left = collision.fX + fX;
+	double bottom = collision.fY + fY;
+
+	if (right <= top && right <= left && right <= bottom)
+		return 0;
+	else if (top <= left && top <= bottom)
+		return 1;
+	else if (left <= bottom)
+		return 2;
+
+	return 3;
+}
@@ -39,7 +39,18 @@ public:
 	double AngleIncidence(const Vector & collision, const Vector & velocity);
 	Vector ReflectVector(const Vector & collision, const Vector & velocity);
 	Vector CollisionPoint(const Vector & initial, const Vector & velocity); 
+	// Boundary coordinate starts at the corner (x,-y) and runs
+	// anticlockwise: right, top, left then bottom wall.
+	double BoundaryPosition(const Vector & collision);
+	double BoundaryLength();
+	Vector BoundaryPoint(double s);
+	Vector Normal(const Vector & collision);
+	// Walls are 0=right 1=top 2=left 3=bottom.
+	int Component(const Vector & collision);
+	int ComponentCount() { return 4; }
+	double Curvature(const Vector & collision) { return 0; }
 private:
+
 	// Dimensions of the table, parameterised by fX and fY. Length of table
 	// is 2fX and width is 2fY. Centre is at (0,0).
 	double fX;
@@ -0,0 +1,277 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the Scheduler class.
+ */
+
+#include <chrono>
+#include <algorithm>
+
+#include "Scheduler.h"
+#include "Parallel.h"
+
+// Scheduler whose Run or Worker the current thread is inside, and its
+// thread index there, so a Run from inside a task can be spotted.
+static thread_local Scheduler * tRunning = 0;
+static thread_local int tThread = 0;
+
+Scheduler::Scheduler(int threads) :
+	fThreads(std::max(threads, 1)), fQueues(fThreads), fStats(fThreads), fPending(0),
+	fGeneration(0), fVersion(0), fWorking(0), fStop(false), fWall(0)
+{
+	ResetStatistics();
+
+	//Thread 0 is whichever calls Run.
+	for (int t = 1; t < fThreads; t++)
+		fPool.push_back(std::thread(&Scheduler::Sleep, this, t));
+}
+
+Scheduler::~Scheduler()
+{
+	{
+		std::lock_guard<std::mutex> guard(fWakeLock);
+		fStop = true;
+	}
+	fStart.notify_all();
+
+	for (unsigned int t = 0; t != fPool.size(); t++)
+		fPool[t].join();
+}
+
+void Scheduler::Run(int n, const Body & body, int grain)
+{
+	if (n <= 0)
+		return;
+
+	//Nested inside one of this scheduler's tasks: the other threads are
+	//busy with the outer Run, so just do it here.
+	if (tRunning == this)
+	{
+		body(0, n, tThread);
+		return;
+	}
+
+	std::lock_guard<std::mutex> run(fRunLock);
+
+	if (grain <= 0)
+		grain = std::max(1, n / (fThreads * 32));
+
+	std::shared_ptr<Body> shared(new Body(body));
+	int threads = std::min(fThreads, n);
+
+	//Equal blocks to start with, stealing evens out the rest.
+	fPending = n;
+	for (int t = 0; t != threads; t++)
+	{
+		Task task = {(int)((long long)n * t / threads), (int)((long long)n * (t + 1) / threads), grain, shared};
+		fQueues[t].fTasks.push_back(task);
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	{
+		std::lock_guard<std::mutex> guard(fWakeLock);
+		fGeneration++;
+		fWorking = fThreads - 1;
+	}
+	fStart.notify_all();
+
+	tRunning = this;
+	tThread = 0;
+	Worker(0);
+	tRunning = 0;
+
+	//Every thread must be out of Worker before the next Run.
+	{
+		std::unique_lock<std::mutex> lock(fWakeLock);
+		fDone.wait(lock, [&]() { return fWorking == 0; });
+	}
+
+	fWall += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+double Scheduler::Imbalance() const
+{
+	double most = 0, total = 0;
+
+	for (int t = 0; t != fThreads; t++)
+	{
+		most = std::max(most, fStats[t].fBusy);
+		total += fStats[t].fBusy;
+	}
+
+	return total > 0 ? most * fThreads / total : 1;
+}
+
+void Scheduler::ResetStatistics()
+{
+	for (int t = 0; t != fThreads; t++)
+	{
+		fStats[t].fItems = 0;
+		fStats[t].fPieces = 0;
+		fStats[t].fSteals = 0;
+		fStats[t].fBusy = 0;
+	}
+
+	fWall = 0;
+}
+
+void Scheduler::WriteStatistics(FILE * file) const
+{
+	fprintf(file, "%-10s%-16s%-12s%-12s%-16s\n", "thread", "items", "pieces", "steals", "busy (s)");
+
+	for (int t = 0; t != fThreads; t++)
+		fprintf(file, "%-10i%-16li%-12li%-12li%-16.4f\n", t, fStats[t].fItems, fStats[t].fPieces,
+			fStats[t].fSteals, fStats[t].fBusy);
+
+	fprintf(file, "Wall time %.4f s, imbalance (busiest / mean) %.3f\n", fWall, Imbalance());
+}
+
+Scheduler & Scheduler::Global()
+{
+	static Scheduler scheduler(ThreadCount());
+	return scheduler;
+}
+
+void Scheduler::Worker(int thread)
+{
+	Task task;
+	Statistics & stats = fStats[thread];
+
+	while (fPending > 0)
+	{
+		//Read before looking for work, so a change made while looking isn't
+		//missed.
+		long version = fVersion;
+
+		if (!Pop(thread, task))
+		{
+			//Nothing to take: wait for some to be stolen onto a deque, or
+			//for the last piece to finish, rather than spinning.
+			if (!Steal(thread))
+			{
+				std::unique_lock<std::mutex> lock(fWakeLock);
+				fWork.wait(lock, [&]() { return fPending == 0 || fVersion != version; });
+			}
+			continue;
+		}
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		(*task.fBody)(task.fBegin, task.fEnd, thread);
+
+		stats.fBusy += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		stats.fItems += task.fEnd - task.fBegin;
+		stats.fPieces++;
+
+		if ((fPending -= task.fEnd - task.fBegin) == 0)
+			Signal();
+	}
+}
+
+void Scheduler::Sleep(int thread)
+{
+	tRunning = this;
+	tThread = thread;
+
+	long seen = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(fWakeLock);
+			fStart.wait(lock, [&]() { return fStop || fGeneration != seen; });
+
+			if (fStop)
+				return;
+			seen = fGeneration;
+		}
+
+		Worker(thread);
+
+		{
+			std::lock_guard<std::mutex> guard(fWakeLock);
+			fWorking--;
+		}
+		fDone.notify_one();
+	}
+}
+
+void Scheduler::Signal()
+{
+	{
+		std::lock_guard<std::mutex> guard(fWakeLock);
+		fVersion++;
+	}
+	fWork.notify_all();
+}
+
+bool Scheduler::Pop(int thread, Task & task)
+{
+	Queue & queue = fQueues[thread];
+	std::lock_guard<std::mutex> guard(queue.fLock);
+
+	if (queue.fTasks.empty())
+		return false;
+
+	Task & back = queue.fTasks.back();
+
+	//Take one grain off the end, leaving the rest to be stolen.
+	if (back.fEnd - back.fBegin > back.fGrain)
+	{
+		task = back;
+		task.fBegin = back.fEnd - back.fGrain;
+		back.fEnd = task.fBegin;
+	}
+	else
+	{
+		task = back;
+		queue.fTasks.pop_back();
+	}
+
+	return true;
+}
+
+bool Scheduler::Steal(int thread)
+{
+	Task task;
+
+	for (int k = 1; k < fThreads; k++)
+	{
+		Queue & victim = fQueues[(thread + k) % fThreads];
+		{
+			std::lock_guard<std::mutex> guard(victim.fLock);
+
+			if (victim.fTasks.empty())
+				continue;
+
+			//Oldest range is at the front, and is likely the largest.
+			Task & front = victim.fTasks.front();
+			task = front;
+
+			if (front.fEnd - front.fBegin > front.fGrain)
+			{
+				int middle = front.fBegin + (front.fEnd - front.fBegin) / 2;
+				front.fEnd = middle;
+				task.fBegin = middle;
+			}
+			else
+			{
+				victim.fTasks.pop_front();
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> guard(fQueues[thread].fLock);
+			fQueues[thread].fTasks.push_back(task);
+			fStats[thread].fSteals++;
+		}
+
+		//What is left of the stolen range can be stolen again.
+		Signal();
+
+		return true;
+	}
+
+	return false;
+}
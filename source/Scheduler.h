@@ -0,0 +1,197 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the Scheduler class.
+ */
+
+#ifndef _SCHEDULER_H
+#define _SCHEDULER_H
+
+#include <cstdio>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <functional>
+
+/**
+ * Work-stealing task scheduler underneath ParallelFor. Work is a range of
+ * indices [begin, end) with a function to call on it. Each thread has its own
+ * deque of ranges: it takes small pieces (the grain) off the back of its own
+ * deque, and when that runs dry it steals half of the range at the front of
+ * another thread's deque. Ranges that finish quickly (escaped balls, short
+ * runs) therefore don't leave threads idle while others still have work.
+ *
+ * Which thread runs which index is not fixed, so results should be written
+ * by index (see Map) or into per-thread accumulators which are then reduced;
+ * only the former gives the same answer, bit for bit, from run to run.
+ *
+ * The worker threads are started once and sleep between Runs, and while
+ * there is nothing to steal, so Run can be called in a tight loop (e.g. once
+ * per time step) without starting threads or spinning idle cores each time.
+ *
+ * A Run called from inside a task is done serially on that thread, and Runs
+ * called from different threads at once take turns.
+ */
+class Scheduler
+{
+public:
+	// Function called on a range of indices by one of the threads.
+	typedef std::function<void(int begin, int end, int thread)> Body;
+
+	/**
+	 * Constructor for a scheduler using threads threads, one of which is
+	 * always the thread calling Run. The others are started here.
+	 */
+	Scheduler(int threads);
+	/**
+	 * Destructor, stops the worker threads.
+	 */
+	~Scheduler();
+
+	/**
+	 * Calls body on pieces of [0, n) in parallel, returning once every
+	 * piece is finished. Each thread starts with an equal block of the
+	 * range.
+	 *
+	 * int n: size of the range.
+	 * Body & body: function to call on each piece.
+	 * int grain: largest piece handed to body at once, 0 to choose one
+	 * giving each thread a few dozen pieces.
+	 */
+	void Run(int n, const Body & body, int grain = 0);
+
+	/**
+	 * Calls function on every index in [0, n) in parallel, and returns the
+	 * results in index order.
+	 */
+	template <class T>
+	std::vector<T> Map(int n, const std::function<T(int index)> & function)
+	{
+		std::vector<T> results(n);
+
+		Run(n, [&](int begin, int end, int thread)
+		{
+			for (int i = begin; i != end; i++)
+				results[i] = function(i);
+		});
+
+		return results;
+	}
+
+	// Load balance statistics, summed over every Run since the last reset.
+	int GetThreads() const { return fThreads; }
+	long GetItems(int thread) const { return fStats[thread].fItems; }
+	long GetPieces(int thread) const { return fStats[thread].fPieces; }
+	long GetSteals(int thread) const { return fStats[thread].fSteals; }
+	double GetBusy(int thread) const { return fStats[thread].fBusy; }
+	double GetWall() const { return fWall; }
+
+	/**
+	 * Busiest thread's time running tasks over the mean, 1 for perfect
+	 * balance.
+	 */
+	double Imbalance() const;
+
+	/**
+	 * Clears the load balance statistics.
+	 */
+	void ResetStatistics();
+
+	/**
+	 * Writes the load balance statistics, one line per thread.
+	 *
+	 * FILE * file: file stream to write to, e.g. stdout.
+	 */
+	void WriteStatistics(FILE * file) const;
+
+	/**
+	 * Shared scheduler with ThreadCount() threads, used by ParallelFor.
+	 */
+	static Scheduler & Global();
+
+private:
+	// A range of indices still to do.
+	struct Task
+	{
+		int fBegin;
+		int fEnd;
+		int fGrain;
+		std::shared_ptr<Body> fBody;
+	};
+
+	// One deque per thread, locked separately so threads rarely wait.
+	struct Queue
+	{
+		std::mutex fLock;
+		std::deque<Task> fTasks;
+	};
+
+	struct Statistics
+	{
+		long fItems;
+		long fPieces;
+		long fSteals;
+		double fBusy;
+	};
+
+	/**
+	 * Loop run by each thread until there is no work left anywhere. Waits
+	 * on fWork while there is work pending but none to take.
+	 */
+	void Worker(int thread);
+
+	/**
+	 * Loop run by each of the started threads for the life of the
+	 * scheduler, sleeping until a Run wakes it to call Worker.
+	 */
+	void Sleep(int thread);
+
+	/**
+	 * Wakes any threads waiting for work, after work was moved or the last
+	 * of it finished.
+	 */
+	void Signal();
+
+	/**
+	 * Takes a piece of at most the grain off the back of thread's deque.
+	 */
+	bool Pop(int thread, Task & task);
+
+	/**
+	 * Moves half of the front range of another thread's deque onto the
+	 * back of thread's deque.
+	 */
+	bool Steal(int thread);
+
+	int fThreads;
+	std::vector<Queue> fQueues;
+	std::vector<Statistics> fStats;
+
+	// Indices of the current Run not yet finished.
+	std::atomic<long> fPending;
+
+	// Started threads, 1 to fThreads - 1.
+	std::vector<std::thread> fPool;
+	// One Run at a time.
+	std::mutex fRunLock;
+	// Guards the counters below, which the condition variables wait on.
+	std::mutex fWakeLock;
+	// Started threads wait on fStart for the next Run, idle threads on
+	// fWork for a change of fVersion, and Run on fDone for fWorking to
+	// reach 0.
+	std::condition_variable fStart;
+	std::condition_variable fWork;
+	std::condition_variable fDone;
+	long fGeneration;
+	std::atomic<long> fVersion;
+	int fWorking;
+	bool fStop;
+
+	double fWall;
+};
+
+#endif
@@ -0,0 +1,53 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the Shadow class.
+ */
+
+#include "Shadow.h"
+
+Shadow::Shadow(ITable & table, int type, const double params[], const Vector & position, const Vector & velocity) :
+	fTable(&table), fKernel(type, params), fPosition(position), fVelocity(velocity), fShadowPosition(position),
+	fShadowVelocity(velocity), fSpeed(velocity.Mod()), fBounces(0), fLost(false)
+{}
+
+Shadow::~Shadow()
+{}
+
+bool Shadow::Step()
+{
+	if (fLost)
+		return false;
+
+	//Same steps as InnerRun.
+	fPosition = fTable->CollisionPoint(fPosition, fVelocity);
+	fVelocity = fTable->ReflectVector(fPosition, fVelocity);
+
+	fBounces++;
+
+	if (fKernel.Step(fShadowPosition, fShadowVelocity) < 0)
+		fLost = true;
+
+	return !fLost;
+}
+
+double Shadow::Distance() const
+{
+	//Differences taken in double-double, so they are exact.
+	Vector dp = (fShadowPosition - TVector<DoubleDouble>(fPosition)).ToVector();
+	Vector dv = (fShadowVelocity - TVector<DoubleDouble>(fVelocity)).ToVector();
+
+	return dp.Mod() + dv.Mod() / fSpeed;
+}
+
+long Shadow::Horizon(double tolerance, long maxBounces)
+{
+	while (fBounces < maxBounces)
+	{
+		//Compare as !(<=) so a NaN counts as parted.
+		if (!Step() || !(Distance() <= tolerance))
+			return fBounces - 1;
+	}
+
+	return maxBounces;
+}
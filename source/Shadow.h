@@ -0,0 +1,91 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the Shadow class.
+ */
+
+#ifndef _SHADOW_H
+#define _SHADOW_H
+
+#include "ITable.h"
+#include "Vector.h"
+#include "TVector.h"
+#include "TableKernel.h"
+#include "DoubleDouble.h"
+
+/**
+ * Runs a ball in double precision, exactly as InnerRun does, alongside a
+ * shadow of the same ball in double-double precision. While the two agree
+ * the double trajectory can be trusted; once rounding errors have been
+ * blown up by the chaos they part, and the double run after that point is
+ * only statistically meaningful. The bounce where they part by more than a
+ * tolerance is the predictability horizon.
+ */
+class Shadow
+{
+public:
+	/**
+	 * Constructor, starting both balls from position and velocity.
+	 *
+	 * ITable & table: table for the double run.
+	 * int type: table type for the shadow, as for CreateTable.
+	 * double params[]: table geometry for the shadow, as for CreateTable.
+	 */
+	Shadow(ITable & table, int type, const double params[], const Vector & position, const Vector & velocity);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~Shadow();
+
+	// Getters.
+	const Vector & GetPosition() const { return fPosition; }
+	const Vector & GetVelocity() const { return fVelocity; }
+	long GetBounces() const { return fBounces; }
+	bool IsLost() const { return fLost; }
+
+	/**
+	 * Advances both balls by one bounce.
+	 *
+	 * return: false if the shadow missed every wall, after which it is
+	 * lost and stays where it was.
+	 */
+	bool Step();
+
+	/**
+	 * Phase space distance between the double run and its shadow, the
+	 * distance between positions plus the distance between velocities as a
+	 * fraction of the speed.
+	 *
+	 * return: distance between the two.
+	 */
+	double Distance() const;
+
+	/**
+	 * Steps until the two are further apart than tolerance, the shadow is
+	 * lost (see IsLost), or maxBounces bounces have been made.
+	 *
+	 * double tolerance: largest trusted phase space distance.
+	 * long maxBounces: most bounces to try.
+	 * return: number of bounces which were within tolerance (before the
+	 * shadow was lost), maxBounces if they never parted.
+	 */
+	long Horizon(double tolerance, long maxBounces);
+
+private:
+	ITable * fTable;
+	TableKernel<DoubleDouble> fKernel;
+
+	// Double run.
+	Vector fPosition;
+	Vector fVelocity;
+
+	// Shadow.
+	TVector<DoubleDouble> fShadowPosition;
+	TVector<DoubleDouble> fShadowVelocity;
+
+	double fSpeed;
+	long fBounces;
+	bool fLost;
+};
+
+#endif
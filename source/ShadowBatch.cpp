@@ -0,0 +1,108 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the ShadowBatch class.
+ */
+
+#include "ShadowBatch.h"
+
+ShadowBatch::ShadowBatch(ITable & table, int type, const double params[]) :
+	fTable(&table), fKernel(type, params), fShadowPosition(Lanes(0), Lanes(0)), fShadowVelocity(Lanes(0), Lanes(0))
+{
+	for (int lane = 0; lane != kLanes; lane++)
+	{
+		fSpeed[lane] = 0;
+		fBounces[lane] = 0;
+		fBall[lane] = -1;
+	}
+}
+
+ShadowBatch::~ShadowBatch()
+{}
+
+void ShadowBatch::Horizons(const Vector position[], const Vector velocity[], int n, double tolerance, long maxBounces, long horizon[], char lost[])
+{
+	//As Shadow::Horizon, which tries no bounces at all for these.
+	if (maxBounces < 1)
+	{
+		for (int i = 0; i != n; i++)
+		{
+			horizon[i] = maxBounces;
+			lost[i] = 0;
+		}
+		return;
+	}
+
+	int next = 0;
+	int running = 0;
+
+	for (int lane = 0; lane != kLanes && next != n; lane++)
+	{
+		Load(lane, next, position[next], velocity[next]);
+		next++;
+		running++;
+	}
+
+	while (running > 0)
+	{
+		//Idle lanes are stepped along with the rest, and ignored.
+		Lanes time = fKernel.Step(fShadowPosition, fShadowVelocity);
+
+		for (int lane = 0; lane != kLanes; lane++)
+		{
+			int ball = fBall[lane];
+			if (ball < 0)
+				continue;
+
+			//Same steps as Shadow::Step.
+			fPosition[lane] = fTable->CollisionPoint(fPosition[lane], fVelocity[lane]);
+			fVelocity[lane] = fTable->ReflectVector(fPosition[lane], fVelocity[lane]);
+			fBounces[lane]++;
+
+			bool gone = time.Get(lane) < DoubleDouble(0);
+
+			//Compare as !(<=) so a NaN counts as parted.
+			if (gone || !(Distance(lane) <= tolerance))
+				horizon[ball] = fBounces[lane] - 1;
+			else if (fBounces[lane] == maxBounces)
+				horizon[ball] = maxBounces;
+			else
+				continue;
+
+			lost[ball] = gone;
+
+			//The lane takes the next ball, or is left idle.
+			if (next != n)
+			{
+				Load(lane, next, position[next], velocity[next]);
+				next++;
+			}
+			else
+			{
+				fBall[lane] = -1;
+				running--;
+			}
+		}
+	}
+}
+
+void ShadowBatch::Load(int lane, int ball, const Vector & position, const Vector & velocity)
+{
+	fBall[lane] = ball;
+	fPosition[lane] = position;
+	fVelocity[lane] = velocity;
+	fSpeed[lane] = velocity.Mod();
+	fBounces[lane] = 0;
+
+	fKernel.SetLane(fShadowPosition, lane, TVector<DoubleDouble>(position));
+	fKernel.SetLane(fShadowVelocity, lane, TVector<DoubleDouble>(velocity));
+}
+
+double ShadowBatch::Distance(int lane) const
+{
+	//Differences taken in double-double, so they are exact.
+	Vector dp = (fKernel.GetLane(fShadowPosition, lane) - TVector<DoubleDouble>(fPosition[lane])).ToVector();
+	Vector dv = (fKernel.GetLane(fShadowVelocity, lane) - TVector<DoubleDouble>(fVelocity[lane])).ToVector();
+
+	return dp.Mod() + dv.Mod() / fSpeed[lane];
+}
@@ -0,0 +1,86 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the ShadowBatch class.
+ */
+
+#ifndef _SHADOWBATCH_H
+#define _SHADOWBATCH_H
+
+#include "ITable.h"
+#include "Vector.h"
+#include "TVector.h"
+#include "BatchKernel.h"
+
+/**
+ * Finds the predictability horizons of many balls as Shadow::Horizon does,
+ * but with kLanes shadows run at once through a BatchKernel. Each lane
+ * holds one ball until it parts from its shadow, loses the table or
+ * reaches the bounce limit, and then takes the next ball, so the lanes stay
+ * full however the horizons differ.
+ *
+ * Each horizon is the same as Shadow::Horizon gives for that ball alone.
+ */
+class ShadowBatch
+{
+public:
+	// Balls run at once.
+	static const int kLanes = 4;
+
+	/**
+	 * Constructor.
+	 *
+	 * ITable & table: table for the double runs.
+	 * int type: table type for the shadows, as for CreateTable.
+	 * double params[]: table geometry for the shadows, as for CreateTable.
+	 */
+	ShadowBatch(ITable & table, int type, const double params[]);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~ShadowBatch();
+
+	/**
+	 * Finds the horizon of each of n balls, as Shadow::Horizon.
+	 *
+	 * Vector position[]: initial positions of the balls.
+	 * Vector velocity[]: initial velocities of the balls.
+	 * int n: number of balls.
+	 * double tolerance: largest trusted phase space distance.
+	 * long maxBounces: most bounces to try.
+	 * long horizon[]: set to the horizon of each ball.
+	 * char lost[]: set to 1 where the ball's shadow was lost, 0 elsewhere.
+	 */
+	void Horizons(const Vector position[], const Vector velocity[], int n, double tolerance, long maxBounces, long horizon[], char lost[]);
+
+private:
+	typedef DoubleDoubleLanes<kLanes> Lanes;
+
+	/**
+	 * Starts ball in lane, in both the double run and the shadow.
+	 */
+	void Load(int lane, int ball, const Vector & position, const Vector & velocity);
+
+	/**
+	 * Phase space distance between the double run and the shadow in lane,
+	 * as Shadow::Distance.
+	 */
+	double Distance(int lane) const;
+
+	ITable * fTable;
+	BatchKernel<kLanes> fKernel;
+
+	// Double runs, by lane.
+	Vector fPosition[kLanes];
+	Vector fVelocity[kLanes];
+	double fSpeed[kLanes];
+	long fBounces[kLanes];
+	// Ball in each lane, -1 once there are none left to run.
+	int fBall[kLanes];
+
+	// Shadows.
+	TVector<Lanes> fShadowPosition;
+	TVector<Lanes> fShadowVelocity;
+};
+
+#endif
@@ -0,0 +1,48 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the SharedRaster class.
+ */
+
+#include <algorithm>
+
+#include "SharedRaster.h"
+
+SharedRaster::SharedRaster(Raster & raster, int threads) :
+	fRaster(&raster), fBufferSize(256)
+{
+	//Enough bands that threads rarely want the same one, but few enough
+	//that the buffers stay small next to the raster.
+	int height = std::max(raster.GetHeight(), 1);
+	int rows = std::max(height / 64, 1);
+
+	fBandSize = rows * std::max(raster.GetWidth(), 1);
+	fBands = (height + rows - 1) / rows;
+
+	fLocks = std::vector<std::mutex>(fBands);
+	fBuffers.resize((long) std::max(threads, 1) * fBands);
+	for (unsigned int b = 0; b != fBuffers.size(); b++)
+		fBuffers[b].reserve(fBufferSize);
+}
+
+SharedRaster::~SharedRaster()
+{
+	Flush();
+}
+
+void SharedRaster::Flush()
+{
+	for (unsigned int b = 0; b != fBuffers.size(); b++)
+		if (!fBuffers[b].empty())
+			Empty(fBuffers[b], b % fBands);
+}
+
+void SharedRaster::Empty(std::vector<int> & buffer, int band)
+{
+	std::lock_guard<std::mutex> guard(fLocks[band]);
+
+	for (unsigned int k = 0; k != buffer.size(); k++)
+		fRaster->AddIndex(buffer[k], 1);
+
+	buffer.clear();
+}
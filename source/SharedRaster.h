@@ -0,0 +1,96 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the SharedRaster class.
+ */
+
+#ifndef _SHAREDRASTER_H
+#define _SHAREDRASTER_H
+
+#include <vector>
+#include <mutex>
+
+#include "Raster.h"
+
+/**
+ * Lets several threads draw into one Raster at once, without a full copy of
+ * it per thread. The rows of the raster are split into bands, each with its
+ * own lock. A thread keeps a short buffer of pixel indices for every band,
+ * and when one fills it takes that band's lock and adds them all, so locks
+ * are taken once per buffer rather than once per point, and threads drawing
+ * into different bands never wait for each other.
+ *
+ * Points still in the buffers are only in the raster after Flush, which
+ * must be called once the threads have finished.
+ */
+class SharedRaster
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * Raster & raster: raster to draw into, which must outlive this.
+	 * int threads: number of threads, indexed 0 to threads - 1.
+	 */
+	SharedRaster(Raster & raster, int threads);
+	/**
+	 * Destructor, flushes the buffers.
+	 */
+	~SharedRaster();
+
+	/**
+	 * Adds one to the pixel containing (x, y), as Raster::Add.
+	 *
+	 * int thread: index of the calling thread.
+	 */
+	void Add(double x, double y, int thread)
+	{
+		int index = fRaster->Index(x, y);
+		if (index < 0)
+			return;
+
+		int band = index / fBandSize;
+		std::vector<int> & buffer = fBuffers[thread * fBands + band];
+		buffer.push_back(index);
+		if (buffer.size() == fBufferSize)
+			Empty(buffer, band);
+	}
+
+	/**
+	 * Adds a line segment, as Raster::AddLine.
+	 *
+	 * int thread: index of the calling thread.
+	 */
+	void AddLine(double x0, double y0, double x1, double y1, int thread)
+	{
+		fRaster->Sample(x0, y0, x1, y1, [this, thread](double x, double y) { Add(x, y, thread); });
+	}
+
+	/**
+	 * Adds every buffered point to the raster. Not to be called while other
+	 * threads are still adding.
+	 */
+	void Flush();
+
+private:
+	/**
+	 * Adds a buffer of indices to the raster under its band's lock, and
+	 * empties it.
+	 */
+	void Empty(std::vector<int> & buffer, int band);
+
+	Raster * fRaster;
+
+	// Pixels per band (a whole number of rows), and number of bands.
+	int fBandSize;
+	int fBands;
+
+	// One lock per band.
+	std::vector<std::mutex> fLocks;
+
+	// Buffered pixel indices, for thread t and band b at t * fBands + b.
+	std::vector<std::vector<int> > fBuffers;
+	unsigned int fBufferSize;
+};
+
+#endif
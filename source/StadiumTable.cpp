@@ -241,3 +241,102 @@ Vector StadiumTable::CollisionPoint(const Vector & initial, const Vector & veloc
 
 	return Vector(0,0);
 }
+
+double StadiumTable::BoundaryPosition(const Vector & collision)
+{
+	double angle;
+
+	//Right semi-circle, angle runs from -pi/2 to pi/2:
+	if (collision.fX > fX)
+	{
+		angle = std::atan2(collision.fY, collision.fX - fX);
+		return fY * (angle + M_PI/2);
+	}
+	//Left semi-circle, angle runs from pi/2 to 3pi/2:
+	else if (collision.fX < -fX)
+	{
+		angle = std::atan2(collision.fY, collision.fX + fX);
+		if (angle < 0)
+			angle += 2*M_PI;
+		return M_PI*fY + 2*fX + fY * (angle - M_PI/2);
+	}
+	//Top wall, running right to left:
+	else if (collision.fY > 0)
+		return M_PI*fY + (fX - collision.fX);
+
+	//Bottom wall, running left to right:
+	return 2*M_PI*fY + 2*fX + (collision.fX + fX);
+}
+
+double StadiumTable::BoundaryLength()
+{
+	return 4*fX + 2*M_PI*fY;
+}
+
+Vector StadiumTable::BoundaryPoint(double s)
+{
+	double angle;
+
+	//Same order as BoundaryPosition: right semi-circle, top, left
+	//semi-circle, bottom.
+	if (s < M_PI*fY)
+	{
+		angle = s / fY - M_PI/2;
+		return Vector(fX + fY * std::cos(angle), fY * std::sin(angle));
+	}
+	s -= M_PI*fY;
+
+	if (s < 2*fX)
+		return Vector(fX - s, fY);
+	s -= 2*fX;
+
+	if (s < M_PI*fY)
+	{
+		angle = s / fY + M_PI/2;
+		return Vector(-fX + fY * std::cos(angle), fY * std::sin(angle));
+	}
+	s -= M_PI*fY;
+
+	return Vector(-fX + s, -fY);
+}
+
+Vector StadiumTable::Normal(const Vector & collision)
+{
+	Vector norm;
+
+	//Same regions as BoundaryPosition.
+	if (collision.fX > fX)
+		norm = Vector(fX, 0) - collision;
+	else if (collision.fX < -fX)
+		norm = Vector(-fX, 0) - collision;
+	else if (collision.fY > 0)
+		return Vector(0, -1);
+	else
+		return Vector(0, 1);
+
+	return norm / norm.Mod();
+}
+
+int StadiumTable::Component(const Vector & collision)
+{
+	//Same regions as BoundaryPosition.
+	if (collision.fX > fX)
+		return 0;
+	else if (collision.fX < -fX)
+		return 2;
+	else if (collision.fY > 0)
+		return 1;
+
+	return 3;
+}
+
+double StadiumTable::Curvature(const Vector & collision)
+{
+	//Semi-circles have radius fY, the straight walls are flat.
+	int wall = Component(collision);
+
+	if (wall == 0 || wall == 2)
+		return 1 / fY;
+
+	return 0;
+}
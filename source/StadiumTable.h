@@ -40,6 +40,16 @@ public:
 	double AngleIncidence(const Vector & collision, const Vector & velocity);
 	Vector ReflectVector(const Vector & collision, const Vector & velocity);
 	Vector CollisionPoint(const Vector & initial, const Vector & velocity);	
+	// Boundary coordinate starts at (x,-y), the bottom of the right hand
+	// semi-circle, and runs anticlockwise.
+	double BoundaryPosition(const Vector & collision);
+	double BoundaryLength();
+	Vector BoundaryPoint(double s);
+	Vector Normal(const Vector & collision);
+	// Walls are 0=right semi-circle 1=top 2=left semi-circle 3=bottom.
+	int Component(const Vector & collision);
+	int ComponentCount() { return 4; }
+	double Curvature(const Vector & collision);
 private:
 	// Member variables describing geometry of the stadium billiards table.
 	double fX;
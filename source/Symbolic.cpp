@@ -0,0 +1,210 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the SymbolWriter and BlockEntropy classes.
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include "Symbolic.h"
+#include "Hash.h"
+
+int SymbolBits(int symbols)
+{
+	int bits = 1;
+	while ((1 << bits) < symbols)
+		bits++;
+	return bits;
+}
+
+SymbolWriter::SymbolWriter(const char * filename, int symbols) :
+	fFile(fopen(filename, "wb")), fBits(SymbolBits(symbols)), fPerWord(64 / fBits), fCount(0), fWord(0), fFill(0),
+	fBytes(0)
+{
+	fBuffer.reserve(8192);
+
+	if (!fFile)
+		return;
+
+	//Count is filled in by Close.
+	uint32_t bits = fBits;
+	uint64_t count = 0;
+	fwrite("BSYM", 1, 4, fFile);
+	fwrite(&bits, sizeof(bits), 1, fFile);
+	fwrite(&count, sizeof(count), 1, fFile);
+	fBytes = 16;
+}
+
+SymbolWriter::~SymbolWriter()
+{
+	if (fFile)
+		Close();
+}
+
+void SymbolWriter::Add(int symbol)
+{
+	fWord |= (uint64_t) symbol << (fFill * fBits);
+	fCount++;
+
+	if (++fFill == fPerWord)
+	{
+		fBuffer.push_back(fWord);
+		fWord = 0;
+		fFill = 0;
+
+		if (fBuffer.size() == fBuffer.capacity())
+			Flush();
+	}
+}
+
+long SymbolWriter::Close()
+{
+	if (!fFile)
+		return 0;
+
+	if (fFill > 0)
+	{
+		fBuffer.push_back(fWord);
+		fWord = 0;
+		fFill = 0;
+	}
+	Flush();
+
+	uint64_t count = fCount;
+	fseek(fFile, 8, SEEK_SET);
+	fwrite(&count, sizeof(count), 1, fFile);
+
+	fclose(fFile);
+	fFile = 0;
+
+	return fBytes;
+}
+
+void SymbolWriter::Flush()
+{
+	if (fFile && !fBuffer.empty())
+	{
+		fwrite(&fBuffer[0], sizeof(uint64_t), fBuffer.size(), fFile);
+		fBytes += sizeof(uint64_t) * fBuffer.size();
+	}
+
+	fBuffer.clear();
+}
+
+BlockEntropy::BlockEntropy(int symbols, int maxLength, int bits) :
+	fBits(SymbolBits(symbols)), fLongest(std::max(1, std::min(maxLength, 58 / SymbolBits(symbols)))),
+	fMaxLength(fLongest), fCount(0), fHistory(0), fKeys((size_t) 1 << bits, 0), fCounts((size_t) 1 << bits, 0),
+	fMask(((uint64_t) 1 << bits) - 1), fUsed(0)
+{}
+
+BlockEntropy::~BlockEntropy()
+{}
+
+void BlockEntropy::Add(int symbol)
+{
+	fHistory = (fHistory << fBits) | (uint64_t) symbol;
+	fCount++;
+
+	//Word of each length ending here, tagged with its length.
+	for (int n = 1; n <= fMaxLength && n <= fCount; n++)
+	{
+		uint64_t word = fHistory & (((uint64_t) 1 << (n * fBits)) - 1);
+		Count(word | ((uint64_t) n << 58));
+	}
+}
+
+void BlockEntropy::Count(uint64_t key)
+{
+	uint64_t slot = Hash(key) & fMask;
+
+	while (fKeys[slot] != 0 && fKeys[slot] != key)
+		slot = (slot + 1) & fMask;
+
+	if (fKeys[slot] == key)
+	{
+		fCounts[slot]++;
+		return;
+	}
+
+	//Keep the table under 70% full, so probes stay short.
+	if (fUsed + 1 > 0.7 * fKeys.size() && fMaxLength > 1)
+	{
+		Shrink();
+
+		if ((int)(key >> 58) <= fMaxLength)
+			Count(key);
+		return;
+	}
+
+	fKeys[slot] = key;
+	fCounts[slot] = 1;
+	fUsed++;
+}
+
+void BlockEntropy::Shrink()
+{
+	fMaxLength--;
+
+	std::vector<uint64_t> keys;
+	std::vector<long> counts;
+	for (unsigned int i = 0; i != fKeys.size(); i++)
+	{
+		if (fKeys[i] != 0 && (int)(fKeys[i] >> 58) <= fMaxLength)
+		{
+			keys.push_back(fKeys[i]);
+			counts.push_back(fCounts[i]);
+		}
+		fKeys[i] = 0;
+	}
+
+	fUsed = keys.size();
+
+	for (unsigned int i = 0; i != keys.size(); i++)
+	{
+		uint64_t slot = Hash(keys[i]) & fMask;
+		while (fKeys[slot] != 0)
+			slot = (slot + 1) & fMask;
+
+		fKeys[slot] = keys[i];
+		fCounts[slot] = counts[i];
+	}
+}
+
+void BlockEntropy::Entropies(std::vector<long> & words, std::vector<double> & block) const
+{
+	words.assign(fMaxLength, 0);
+
+	//Sum of c log2 c over the words of each length.
+	std::vector<double> sum(fMaxLength, 0);
+
+	for (unsigned int i = 0; i != fKeys.size(); i++)
+	{
+		if (fKeys[i] == 0)
+			continue;
+
+		int n = fKeys[i] >> 58;
+		words[n - 1]++;
+		sum[n - 1] += fCounts[i] * std::log2((double) fCounts[i]);
+	}
+
+	block.assign(fMaxLength, 0);
+	for (int n = 1; n <= fMaxLength && n <= fCount; n++)
+	{
+		double total = fCount - n + 1;
+		block[n - 1] = std::log2(total) - sum[n - 1] / total;
+	}
+}
+
+int BlockEntropy::Reliable(const std::vector<long> & words) const
+{
+	int reliable = 0;
+
+	for (int n = 1; n <= (int) words.size() && n <= fCount; n++)
+	{
+		if (words[n - 1] * 10 <= fCount - n + 1)
+			reliable = n;
+	}
+
+	return reliable;
+}
@@ -0,0 +1,177 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the SymbolWriter and BlockEntropy classes.
+ */
+
+#ifndef _SYMBOLIC_H
+#define _SYMBOLIC_H
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Number of bits needed to store one of a number of symbols, at least 1.
+ *
+ * int symbols: size of the alphabet.
+ * return: bits per symbol.
+ */
+int SymbolBits(int symbols);
+
+/**
+ * Writes an itinerary (the wall hit at each bounce, see ITable::Component)
+ * to a binary file, packed into as few bits per bounce as the number of
+ * walls allows: 2 bits for the stadium, 3 for the Lorentz table.
+ *
+ * The file starts with a 16 byte header: the 4 characters "BSYM", the bits
+ * per symbol and the number of symbols as 32 and 64 bit integers. It is
+ * followed by 64 bit words, each holding 64 / bits symbols, the first in the
+ * lowest bits. Symbols never straddle two words. Everything is in the byte
+ * order of the machine which wrote it.
+ */
+class SymbolWriter
+{
+public:
+	/**
+	 * Constructor, opening the file.
+	 *
+	 * char * filename: file to write to.
+	 * int symbols: size of the alphabet.
+	 */
+	SymbolWriter(const char * filename, int symbols);
+	/**
+	 * Destructor, closes the file if Close wasn't called.
+	 */
+	~SymbolWriter();
+
+	// Getters.
+	int GetBits() const { return fBits; }
+	long GetCount() const { return fCount; }
+	bool IsOpen() const { return fFile != 0; }
+
+	/**
+	 * Adds the next symbol.
+	 *
+	 * int symbol: from 0 to symbols - 1.
+	 */
+	void Add(int symbol);
+
+	/**
+	 * Writes out the last symbols and the final count, and closes the file.
+	 *
+	 * return: bytes written.
+	 */
+	long Close();
+
+private:
+	/**
+	 * Writes the buffered words to the file.
+	 */
+	void Flush();
+
+	FILE * fFile;
+	int fBits;
+	int fPerWord;
+	long fCount;
+
+	// Word being filled and how many symbols it holds.
+	uint64_t fWord;
+	int fFill;
+	std::vector<uint64_t> fBuffer;
+	long fBytes;
+};
+
+/**
+ * Counts the words (blocks of consecutive symbols) of each length from 1 to
+ * a maximum in a symbol sequence, as the symbols arrive, and estimates the
+ * entropies of the sequence from the counts.
+ *
+ * The last symbols are kept packed in one integer, shifted along by one
+ * symbol at each step, so the word of each length ending at the current
+ * symbol is just its low bits. Words of every length share one open
+ * addressing hash table of fixed size, so memory doesn't grow with the
+ * length of the sequence. If the table fills up, the longest length still
+ * counted is dropped, so the counts kept are always exact.
+ *
+ * The block entropy H(n) is the Shannon entropy of the words of length n.
+ * H(n) - H(n-1) tends to the entropy per symbol of the sequence (the
+ * Kolmogorov-Sinai entropy of the partition), and log2 of the growth in the
+ * number of words seen tends to the topological entropy. Both are only
+ * trustworthy while far fewer words are seen than there are symbols.
+ */
+class BlockEntropy
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * int symbols: size of the alphabet.
+	 * int maxLength: longest words to count, reduced to fit in 58 bits.
+	 * int bits: the hash table has 2^bits entries.
+	 */
+	BlockEntropy(int symbols, int maxLength, int bits = 20);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~BlockEntropy();
+
+	// Getters.
+	int GetMaxLength() const { return fMaxLength; }
+	int GetDropped() const { return fLongest - fMaxLength; }
+	long GetCount() const { return fCount; }
+
+	/**
+	 * Adds the next symbol, counting the word of each length ending with it.
+	 *
+	 * int symbol: from 0 to symbols - 1.
+	 */
+	void Add(int symbol);
+
+	/**
+	 * Works out the entropies from the counts so far.
+	 *
+	 * std::vector<long> & words: set to the number of different words of
+	 * each length, from length 1 at index 0.
+	 * std::vector<double> & block: set to the block entropy in bits of each
+	 * length.
+	 */
+	void Entropies(std::vector<long> & words, std::vector<double> & block) const;
+
+	/**
+	 * Longest length whose counts can be trusted to estimate entropies, where
+	 * there are at least ten symbols in the sequence for each word seen.
+	 *
+	 * std::vector<long> & words: as set by Entropies.
+	 * return: the length, 0 if there is none.
+	 */
+	int Reliable(const std::vector<long> & words) const;
+
+private:
+	/**
+	 * Counts one word, dropping the longest length if the table is full.
+	 */
+	void Count(uint64_t key);
+
+	/**
+	 * Drops the counts of the longest length and rebuilds the table.
+	 */
+	void Shrink();
+
+	int fBits;
+	// Longest words asked for, and the longest still counted.
+	int fLongest;
+	int fMaxLength;
+	long fCount;
+	uint64_t fHistory;
+
+	// Hash table of keys (the word, with its length in the top 6 bits) and
+	// their counts. A key of 0 marks an empty entry.
+	std::vector<uint64_t> fKeys;
+	std::vector<long> fCounts;
+	uint64_t fMask;
+	long fUsed;
+};
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the TVector class template.
+ */
+
+#ifndef _TVECTOR_H
+#define _TVECTOR_H
+
+#include <cmath>
+
+#include "Vector.h"
+
+/**
+ * 2 dimensional vector as Vector, but with components of any floating point
+ * type Real (e.g. float for the fast ensemble). Only the operations needed
+ * by the table kernels are defined.
+ *
+ * Real must support the usual arithmetic and comparisons, construction from
+ * double, and conversion back with double(x). sqrt is found by argument
+ * dependent lookup, so types other than float and double should provide it
+ * in their own namespace.
+ */
+template <typename Real>
+class TVector
+{
+public:
+	/**
+	 * Empty constructor, does not provide any default values.
+	 */
+	TVector() {}
+	/**
+	 * Value constructor, assigns fX(x) and fY(y).
+	 */
+	TVector(Real x, Real y) : fX(x), fY(y) {}
+	/**
+	 * Constructor rounding a double precision Vector to Real.
+	 */
+	explicit TVector(const Vector & other) : fX(Real(other.fX)), fY(Real(other.fY)) {}
+
+	// Addition operators.
+	TVector operator+(const TVector & other) const { return TVector(fX + other.fX, fY + other.fY); }
+	TVector operator-() const { return TVector(-fX, -fY); }
+	TVector operator-(const TVector & other) const { return TVector(fX - other.fX, fY - other.fY); }
+
+	// Scalar operators.
+	TVector operator*(Real mult) const { return TVector(fX * mult, fY * mult); }
+	TVector operator/(Real div) const { return TVector(fX / div, fY / div); }
+	friend TVector operator*(Real lhs, const TVector & rhs) { return rhs * lhs; }
+
+	/**
+	 * Returns the dot product of the vector with other.
+	 */
+	Real Dot(const TVector & other) const { return fX * other.fX + fY * other.fY; }
+	/**
+	 * Modulus of the vector.
+	 */
+	Real Mod() const
+	{
+		using std::sqrt;
+		return sqrt(Dot(*this));
+	}
+	/**
+	 * The vector rounded to double precision.
+	 */
+	Vector ToVector() const { return Vector(double(fX), double(fY)); }
+
+	// Public, as for Vector.
+	Real fX;
+	Real fY;
+};
+
+#endif
@@ -0,0 +1,31 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the table factory function.
+ */
+
+#include "TableFactory.h"
+#include "CircleTable.h"
+#include "EllipseTable.h"
+#include "RectangleTable.h"
+#include "StadiumTable.h"
+#include "LorentzTable.h"
+
+ITable * CreateTable(int type, const double params[])
+{
+	switch (type)
+	{
+		case 1:
+			return new CircleTable(params[0]);
+		case 2:
+			return new EllipseTable(params[0], params[1], params[2]);
+		case 3:
+			return new RectangleTable(params[0], params[1]);
+		case 4:
+			return new StadiumTable(params[0], params[1]);
+		case 5:
+			return new LorentzTable(params[0], params[1], params[2]);
+	}
+
+	return 0;
+}
@@ -0,0 +1,27 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the table factory function.
+ */
+
+#ifndef _TABLEFACTORY_H
+#define _TABLEFACTORY_H
+
+#include "ITable.h"
+
+/**
+ * Creates a billiard table on the heap from a table type and its geometry.
+ * The caller owns the table and must delete it.
+ *
+ * The types follow RandomArgs: 1=circular 2=elliptical 3=rectangular
+ * 4=stadium 5=lorentz. params holds {radius} for the circle, {radius,
+ * xCoef, yCoef} for the ellipse, {x, y} for the rectangle and stadium and
+ * {x, y, radius} for the lorentz table.
+ *
+ * int type: integer 1-5 specifying the type of table.
+ * double params[]: array specifying the geometry of the table.
+ * return: new table, or 0 if type is not recognised.
+ */
+ITable * CreateTable(int type, const double params[]);
+
+#endif
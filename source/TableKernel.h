@@ -0,0 +1,275 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the TableKernel class template.
+ */
+
+#ifndef _TABLEKERNEL_H
+#define _TABLEKERNEL_H
+
+#include <cmath>
+
+#include "TVector.h"
+
+/**
+ * The collision and reflection of a table, written once for any floating
+ * point type Real so the same kernel can be run in single precision (fast)
+ * or extended precision (accurate). Unlike the ITable classes this is a
+ * single class switching on the table type, so there are no virtual calls
+ * in the inner loop.
+ *
+ * The types and geometry follow CreateTable: 1=circular {radius}
+ * 2=elliptical {radius, xCoef, yCoef} 3=rectangular {x, y} 4=stadium {x, y}
+ * 5=lorentz {x, y, radius}.
+ */
+template <typename Real>
+class TableKernel
+{
+public:
+	/**
+	 * Constructor from a table type and its geometry, as for CreateTable.
+	 *
+	 * int type: integer 1-5 specifying the type of table.
+	 * double params[]: array specifying the geometry of the table.
+	 */
+	TableKernel(int type, const double params[]) :
+		fType(type), fA(Real(params[0])), fB(Real(0)), fC(Real(0))
+	{
+		if (type == 2 || type == 5)
+		{
+			fB = Real(params[1]);
+			fC = Real(params[2]);
+		}
+		else if (type == 3 || type == 4)
+		{
+			fB = Real(params[1]);
+		}
+	}
+
+	// Getters.
+	int GetType() const { return fType; }
+
+	/**
+	 * Moves the ball from position along velocity to the next collision, and
+	 * reflects the velocity there.
+	 *
+	 * TVector<Real> & position: position of the ball, set to the collision.
+	 * TVector<Real> & velocity: velocity of the ball, set to the reflected
+	 * velocity.
+	 * return: time taken to reach the collision, or a negative value if no
+	 * collision was found (the ball has been lost through rounding).
+	 */
+	Real Step(TVector<Real> & position, TVector<Real> & velocity) const
+	{
+		TVector<Real> normal;
+		Real time = Collide(position, velocity, normal);
+
+		if (!(time >= Real(0)))
+			return Real(-1);
+
+		position = position + time * velocity;
+		velocity = velocity - Real(2) * velocity.Dot(normal) * normal;
+
+		return time;
+	}
+
+	/**
+	 * How far a point lies outside the table: positive outside, negative
+	 * inside and zero on the edge. This is the distance to the edge for
+	 * every table but the ellipse, where it is scaled by the smaller axis.
+	 *
+	 * TVector<Real> & position: point to check.
+	 * return: signed distance outside the edge.
+	 */
+	Real Outside(const TVector<Real> & position) const
+	{
+		using std::sqrt;
+		Real x = position.fX < Real(0) ? -position.fX : position.fX;
+		Real y = position.fY < Real(0) ? -position.fY : position.fY;
+
+		switch (fType)
+		{
+			case 1:
+				return position.Mod() - fA;
+			case 2:
+			{
+				Real u = position.fX / fB, w = position.fY / fC;
+				return (sqrt(u * u + w * w) - fA) * (fB < fC ? fB : fC);
+			}
+			case 3:
+				return Max(x - fA, y - fB);
+			case 4:
+				if (x <= fA)
+					return y - fB;
+				return TVector<Real>(x - fA, y).Mod() - fB;
+			case 5:
+				return Max(Max(x - fA, y - fB), fC - position.Mod());
+		}
+
+		return Real(0);
+	}
+
+private:
+	/**
+	 * Finds the next collision along velocity and the unit normal there.
+	 *
+	 * return: time to the collision, or a negative value if there is none.
+	 */
+	Real Collide(const TVector<Real> & position, const TVector<Real> & velocity, TVector<Real> & normal) const
+	{
+		Real best(-1);
+
+		switch (fType)
+		{
+			case 1:
+				best = ExitCircle(position, velocity, TVector<Real>(Real(0), Real(0)), fA);
+				normal = Centre(position + best * velocity, TVector<Real>(Real(0), Real(0)));
+				break;
+			case 2:
+			{
+				//Scale to a circle of radius r, x = r*a*cos(t), y = r*b*sin(t).
+				TVector<Real> p(position.fX / fB, position.fY / fC);
+				TVector<Real> v(velocity.fX / fB, velocity.fY / fC);
+				best = ExitCircle(p, v, TVector<Real>(Real(0), Real(0)), fA);
+
+				TVector<Real> hit = position + best * velocity;
+				normal = TVector<Real>(hit.fX / (fB * fB), hit.fY / (fC * fC));
+				normal = normal / normal.Mod();
+				break;
+			}
+			case 3:
+			case 5:
+				best = Walls(position, velocity, normal);
+
+				//Lorentz scatterer, only if it is hit before the walls.
+				if (fType == 5)
+				{
+					Real time = EnterCircle(position, velocity, fC);
+					if (time >= Real(0) && time < best)
+					{
+						best = time;
+						normal = Centre(position + time * velocity, TVector<Real>(Real(0), Real(0)));
+					}
+				}
+				break;
+			case 4:
+			{
+				//Straight walls count only between the arcs, and each arc only
+				//on its own side. The table is convex, so the first valid
+				//candidate is the collision.
+				Real time;
+				if (velocity.fY != Real(0))
+				{
+					Real wall = velocity.fY > Real(0) ? fB : -fB;
+					time = (wall - position.fY) / velocity.fY;
+					Real x = position.fX + time * velocity.fX;
+					if (time >= Real(0) && x <= fA && x >= -fA)
+						Candidate(time, TVector<Real>(Real(0), velocity.fY > Real(0) ? Real(1) : Real(-1)), best, normal);
+				}
+
+				for (int side = -1; side <= 1; side += 2)
+				{
+					TVector<Real> centre(Real(side) * fA, Real(0));
+					time = ExitCircle(position, velocity, centre, fB);
+					TVector<Real> hit = position + time * velocity;
+					if (Real(side) * (hit.fX - centre.fX) >= Real(0))
+						Candidate(time, Centre(hit, centre), best, normal);
+				}
+				break;
+			}
+		}
+
+		return best;
+	}
+
+	/**
+	 * Time for a ball inside a circle to reach its edge, the larger root of
+	 * the quadratic as in the ITable classes.
+	 */
+	static Real ExitCircle(const TVector<Real> & position, const TVector<Real> & velocity, const TVector<Real> & centre, Real radius)
+	{
+		using std::sqrt;
+		TVector<Real> p = position - centre;
+		Real a = velocity.Dot(velocity);
+		Real b = p.Dot(velocity);
+		Real c = p.Dot(p) - radius * radius;
+		Real d = b * b - a * c;
+
+		//Rounding can leave a ball just outside, where d dips below 0.
+		if (d < Real(0))
+			d = Real(0);
+
+		return (-b + sqrt(d)) / a;
+	}
+
+	/**
+	 * Time for a ball outside a circle at the origin to hit it, the smaller
+	 * root. Negative if the ball misses or is moving away.
+	 */
+	static Real EnterCircle(const TVector<Real> & position, const TVector<Real> & velocity, Real radius)
+	{
+		using std::sqrt;
+		Real a = velocity.Dot(velocity);
+		Real b = position.Dot(velocity);
+		Real c = position.Dot(position) - radius * radius;
+		Real d = b * b - a * c;
+
+		if (b >= Real(0) || d <= Real(0))
+			return Real(-1);
+
+		return (-b - sqrt(d)) / a;
+	}
+
+	/**
+	 * Time to reach the rectangle walls at x = +-fA and y = +-fB, setting
+	 * the normal of the wall hit. Negative if neither is ahead.
+	 */
+	Real Walls(const TVector<Real> & position, const TVector<Real> & velocity, TVector<Real> & normal) const
+	{
+		Real best(-1);
+
+		if (velocity.fX != Real(0))
+		{
+			Real wall = velocity.fX > Real(0) ? fA : -fA;
+			Candidate((wall - position.fX) / velocity.fX, TVector<Real>(Real(1), Real(0)), best, normal);
+		}
+		if (velocity.fY != Real(0))
+		{
+			Real wall = velocity.fY > Real(0) ? fB : -fB;
+			Candidate((wall - position.fY) / velocity.fY, TVector<Real>(Real(0), Real(1)), best, normal);
+		}
+
+		return best;
+	}
+
+	/**
+	 * Keeps time and its normal if it is the earliest non-negative time yet.
+	 */
+	static void Candidate(Real time, const TVector<Real> & candidate, Real & best, TVector<Real> & normal)
+	{
+		if (time >= Real(0) && (best < Real(0) || time < best))
+		{
+			best = time;
+			normal = candidate;
+		}
+	}
+
+	/**
+	 * Unit vector from centre to point.
+	 */
+	static TVector<Real> Centre(const TVector<Real> & point, const TVector<Real> & centre)
+	{
+		TVector<Real> r = point - centre;
+		return r / r.Mod();
+	}
+
+	static Real Max(Real a, Real b) { return a > b ? a : b; }
+
+	int fType;
+	// Geometry, in the order given to the constructor.
+	Real fA;
+	Real fB;
+	Real fC;
+};
+
+#endif
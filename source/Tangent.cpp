@@ -0,0 +1,49 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the Tangent class.
+ */
+
+#include <cmath>
+
+#include "Tangent.h"
+
+Tangent::Tangent() :
+	fQ(0, 0), fV(0, 0)
+{}
+
+Tangent::Tangent(const Vector & q, const Vector & v) :
+	fQ(q), fV(v)
+{}
+
+Tangent::~Tangent()
+{}
+
+double Tangent::Mod() const
+{
+	return std::sqrt(Dot(*this));
+}
+
+void Tangent::Flight(double time)
+{
+	fQ = fQ + fV * time;
+}
+
+void Tangent::Bounce(ITable & table, const Vector & collision, const Vector & velocity)
+{
+	Vector norm = table.Normal(collision);
+	Vector tangent(norm.fY, -norm.fX);
+
+	//Change in collision point along the wall: the perturbed ball hits
+	//after an extra time -(n.dq)/(n.v), at collision + dq + v * time.
+	double along = (fQ - velocity * (norm.Dot(fQ) / norm.Dot(velocity))).Dot(tangent);
+
+	//Normal turns as the collision point moves along a curved wall.
+	Vector dNorm = tangent * (-table.Curvature(collision) * along);
+
+	//Reflect both, plus the change in reflection from the turned normal
+	//(Dellago, Posch & Hoover 1996).
+	fQ = fQ - norm * (2 * norm.Dot(fQ));
+	fV = fV - norm * (2 * norm.Dot(fV))
+		- norm * (2 * velocity.Dot(dNorm)) - dNorm * (2 * velocity.Dot(norm));
+}
@@ -0,0 +1,69 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the Tangent class and the linearised billiard flow.
+ */
+
+#ifndef _TANGENT_H
+#define _TANGENT_H
+
+#include "ITable.h"
+#include "Vector.h"
+
+/**
+ * A tangent vector of the billiard flow: a small change in the position and
+ * velocity of the ball, carried along with the trajectory to see how it
+ * grows. The four components (fQ.fX, fQ.fY, fV.fX, fV.fY) are treated as one
+ * vector when taking dot products.
+ */
+class Tangent
+{
+public:
+	/**
+	 * Empty constructor, zero tangent vector.
+	 */
+	Tangent();
+	/**
+	 * Constructor from a change in position q and in velocity v.
+	 */
+	Tangent(const Vector & q, const Vector & v);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~Tangent();
+
+	// Vector operations over all four components.
+	Tangent operator+(const Tangent & other) const { return Tangent(fQ + other.fQ, fV + other.fV); }
+	Tangent operator-(const Tangent & other) const { return Tangent(fQ - other.fQ, fV - other.fV); }
+	Tangent operator*(double mult) const { return Tangent(fQ * mult, fV * mult); }
+	double Dot(const Tangent & other) const { return fQ.Dot(other.fQ) + fV.Dot(other.fV); }
+	double Mod() const;
+
+	/**
+	 * Moves the tangent vector along a free flight of the given time, during
+	 * which the change in velocity adds up into the change in position.
+	 *
+	 * double time: time of flight.
+	 */
+	void Flight(double time);
+
+	/**
+	 * Applies the linearised bounce at a collision, so that a tangent vector
+	 * of the incoming trajectory becomes one of the outgoing trajectory. Both
+	 * are taken at the same time, the moment the reference ball hits the
+	 * wall. The perturbed ball hits slightly earlier or later, at a slightly
+	 * different point where the wall is turned by the curvature, which is
+	 * where the growth comes from on curved walls.
+	 *
+	 * ITable & table: billiard table, for the normal and curvature.
+	 * Vector & collision: point where the reference ball hits the wall.
+	 * Vector & velocity: velocity of the reference ball before the bounce.
+	 */
+	void Bounce(ITable & table, const Vector & collision, const Vector & velocity);
+
+	// Member variables are public, as with Vector.
+	Vector fQ;
+	Vector fV;
+};
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the TilePyramid class.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <sys/stat.h>
+
+#include "TilePyramid.h"
+
+TilePyramid::TilePyramid()
+{}
+
+TilePyramid::TilePyramid(int tileSize, double xMin, double xMax, double yMin, double yMax) :
+	fTileSize(tileSize), fXMin(xMin), fXMax(xMax), fYMin(yMin), fYMax(yMax)
+{}
+
+TilePyramid::~TilePyramid()
+{}
+
+void TilePyramid::TileArea(int z, int x, int y, double & xMin, double & xMax, double & yMin, double & yMax) const
+{
+	double width = (fXMax - fXMin) / (1 << z);
+	double height = (fYMax - fYMin) / (1 << z);
+
+	//Tile rows count down from the top.
+	xMin = fXMin + x * width;
+	xMax = xMin + width;
+	yMax = fYMax - y * height;
+	yMin = yMax - height;
+}
+
+void TilePyramid::TileAngles(int z, int x, int y, double & thetaMin, double & thetaMax) const
+{
+	double xMin, xMax, yMin, yMax;
+	TileArea(z, x, y, xMin, xMax, yMin, yMax);
+
+	//Every angle passes through a tile round the origin.
+	if (xMin <= 0 && xMax >= 0 && yMin <= 0 && yMax >= 0)
+	{
+		thetaMin = -M_PI;
+		thetaMax = M_PI;
+		return;
+	}
+
+	//Otherwise measure the corners from the direction of the centre, which
+	//can't be more than pi/2 away, so there is no wrapping to worry about.
+	double centre = std::atan2((yMin + yMax) / 2, (xMin + xMax) / 2);
+	double xs[4] = {xMin, xMax, xMin, xMax};
+	double ys[4] = {yMin, yMin, yMax, yMax};
+
+	thetaMin = thetaMax = 0;
+	for (int k = 0; k != 4; k++)
+	{
+		double angle = std::atan2(ys[k], xs[k]) - centre;
+		angle = std::remainder(angle, 2*M_PI);
+
+		if (angle < thetaMin)
+			thetaMin = angle;
+		if (angle > thetaMax)
+			thetaMax = angle;
+	}
+
+	thetaMin += centre;
+	thetaMax += centre;
+}
+
+Raster TilePyramid::TileRaster(int z, int x, int y, int depth) const
+{
+	double xMin, xMax, yMin, yMax;
+	TileArea(z, x, y, xMin, xMax, yMin, yMax);
+
+	int size = fTileSize << (depth - 1);
+
+	return Raster(size, size, xMin, xMax, yMin, yMax);
+}
+
+int TilePyramid::Write(const Raster & raster, const char * directory, int z, int x, int y, int depth) const
+{
+	int written = 0;
+	Raster level = raster;
+
+	mkdir(directory, 0755);
+
+	//Finest level first, halving the resolution each time.
+	for (int d = depth - 1; d >= 0; d--)
+	{
+		std::string path = std::string(directory) + "/" + std::to_string(z + d);
+		mkdir(path.c_str(), 0755);
+
+		//Same white point for every tile in the level.
+		double white = level.Quantile(0.999);
+		int tiles = 1 << d;
+
+		for (int j = 0; j != tiles; j++)
+		{
+			for (int i = 0; i != tiles; i++)
+			{
+				Raster tile = level.Crop(i * fTileSize, j * fTileSize, fTileSize, fTileSize);
+				std::string name = path + "/" + std::to_string((x << d) + i) + "_" + std::to_string((y << d) + j) + ".pgm";
+
+				if (tile.WriteScaledPGM(name.c_str(), white))
+					written++;
+			}
+		}
+
+		if (d > 0)
+			level = level.Downsample();
+	}
+
+	return written;
+}
@@ -0,0 +1,92 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the TilePyramid class.
+ */
+
+#ifndef _TILEPYRAMID_H
+#define _TILEPYRAMID_H
+
+#include "Raster.h"
+
+/**
+ * Multi-resolution pyramid of square image tiles, for zooming into large
+ * density images. Level 0 is a single tile covering the whole area, and each
+ * level down splits every tile into four, so level z has 2^z x 2^z tiles.
+ * Tiles are written as 'directory/z/x_y.pgm', with tile (0, 0) in the top
+ * left corner.
+ *
+ * Every tile of a level is tone mapped with the same white point, so tiles
+ * can be put side by side.
+ */
+class TilePyramid
+{
+public:
+	/**
+	 * Empty constructor, does not initialise values.
+	 */
+	TilePyramid();
+	/**
+	 * Constructor for a pyramid of tileSize x tileSize pixel tiles, whose
+	 * level 0 tile covers x from xMin to xMax and y from yMin to yMax.
+	 */
+	TilePyramid(int tileSize, double xMin, double xMax, double yMin, double yMax);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~TilePyramid();
+
+	// Getters.
+	int GetTileSize() const { return fTileSize; }
+
+	/**
+	 * Finds the area covered by a tile.
+	 *
+	 * int z, x, y: level and position of the tile.
+	 * double & xMin, xMax, yMin, yMax: set to the area covered.
+	 */
+	void TileArea(int z, int x, int y, double & xMin, double & xMax, double & yMin, double & yMax) const;
+
+	/**
+	 * Finds the range of polar angles, seen from the origin, which pass
+	 * through a tile. This is the whole circle if the tile contains the
+	 * origin. The range may run past pi, so it does not wrap.
+	 *
+	 * int z, x, y: level and position of the tile.
+	 * double & thetaMin, thetaMax: set to the range of angles.
+	 */
+	void TileAngles(int z, int x, int y, double & thetaMin, double & thetaMax) const;
+
+	/**
+	 * Makes an empty raster covering a tile at enough resolution to write
+	 * it and depth - 1 further levels beneath it.
+	 *
+	 * int z, x, y: level and position of the tile.
+	 * int depth: number of levels to write from it.
+	 * return: raster covering the tile.
+	 */
+	Raster TileRaster(int z, int x, int y, int depth) const;
+
+	/**
+	 * Writes the tile (z, x, y) and all the tiles beneath it, down to
+	 * depth - 1 levels further, from a raster made by TileRaster.
+	 * Directories are created as needed. Use z = x = y = 0 for the whole
+	 * pyramid.
+	 *
+	 * Raster & raster: filled raster from TileRaster(z, x, y, depth).
+	 * char * directory: top directory of the pyramid.
+	 * int z, x, y: level and position of the top tile.
+	 * int depth: number of levels to write.
+	 * return: number of tiles written.
+	 */
+	int Write(const Raster & raster, const char * directory, int z, int x, int y, int depth) const;
+
+private:
+	int fTileSize;
+	double fXMin;
+	double fXMax;
+	double fYMin;
+	double fYMax;
+};
+
+#endif
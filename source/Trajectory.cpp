@@ -0,0 +1,60 @@
+/**
+ * 19/10/2026
+ *
+ * Source file for the Trajectory and Bounce classes.
+ */
+
+#include "Trajectory.h"
+
+Bounce::Bounce() :
+	fIndex(0), fPosition(0, 0), fIncoming(0, 0), fVelocity(0, 0), fLength(0), fTime(0)
+{}
+
+Bounce::~Bounce()
+{}
+
+Trajectory::Trajectory(ITable & table, const Vector & position, const Vector & velocity) :
+	fTable(&table), fMonitor(0), fStarted(false)
+{
+	fLast.fPosition = position;
+	fLast.fIncoming = velocity;
+	fLast.fVelocity = velocity;
+}
+
+Trajectory::~Trajectory()
+{}
+
+bool Trajectory::Next(Bounce & bounce)
+{
+	//Starting state first.
+	if (!fStarted)
+	{
+		fStarted = true;
+		bounce = fLast;
+		return true;
+	}
+
+	Vector collision = fTable->CollisionPoint(fLast.fPosition, fLast.fVelocity);
+	Vector velocity = fTable->ReflectVector(collision, fLast.fVelocity);
+
+	if (fMonitor && !fMonitor->Inspect(fLast.fPosition, collision, fLast.fVelocity, velocity))
+		return false;
+
+	fLast.fIndex++;
+	fLast.fLength = (collision - fLast.fPosition).Mod();
+	fLast.fTime += fLast.fLength / fLast.fVelocity.Mod();
+	fLast.fIncoming = fLast.fVelocity;
+	fLast.fVelocity = velocity;
+	fLast.fPosition = collision;
+
+	bounce = fLast;
+	return true;
+}
+
+void Trajectory::SetMonitor(HealthMonitor * monitor)
+{
+	fMonitor = monitor;
+
+	if (fMonitor)
+		fMonitor->Start(fLast.fVelocity);
+}
@@ -0,0 +1,232 @@
+/**
+ * 19/10/2026
+ *
+ * Header file for the Trajectory class and the range adaptors over it.
+ */
+
+#ifndef _TRAJECTORY_H
+#define _TRAJECTORY_H
+
+#include "ITable.h"
+#include "HealthMonitor.h"
+#include "Vector.h"
+
+/**
+ * One record of a trajectory: a collision with the table wall and the
+ * velocities either side of it. Record 0 is the starting state instead,
+ * with fPosition the initial position and no length.
+ */
+class Bounce
+{
+public:
+	/**
+	 * Empty constructor, record 0 at the origin with zero velocity.
+	 */
+	Bounce();
+	/**
+	 * Destructor, does nothing.
+	 */
+	~Bounce();
+
+	// Number of the bounce, 0 for the starting state.
+	long fIndex;
+	// Point of collision.
+	Vector fPosition;
+	// Velocity before and after the collision.
+	Vector fIncoming;
+	Vector fVelocity;
+	// Path length from the previous record, and total time so far.
+	double fLength;
+	double fTime;
+};
+
+/**
+ * Iterator for range based for loops over anything with a
+ * bool Next(Bounce &) function (a Trajectory or one of the adaptors
+ * below). Each increment pulls one record from the source.
+ */
+template <class Source>
+class RangeIterator
+{
+public:
+	RangeIterator(Source * source) :
+		fSource(source), fDone(source == 0)
+	{
+		if (!fDone)
+			fDone = !fSource->Next(fBounce);
+	}
+
+	const Bounce & operator*() const { return fBounce; }
+	const Bounce * operator->() const { return &fBounce; }
+	RangeIterator & operator++() { fDone = !fSource->Next(fBounce); return *this; }
+	bool operator!=(const RangeIterator & other) const { return fDone != other.fDone; }
+
+private:
+	Source * fSource;
+	Bounce fBounce;
+	bool fDone;
+};
+
+/**
+ * Lazy trajectory of a ball on a table. Nothing is worked out until a
+ * record is asked for, and each record is only worked out once, so
+ * analyses can pull as many bounces as they need and stop early. The
+ * trajectory never ends by itself; limit it with Take. With a HealthMonitor
+ * attached it ends when the monitor stops the run.
+ *
+ * Copying a Trajectory gives an independent trajectory carrying on from the
+ * same point. The table must outlive it.
+ *
+ * for (const Bounce & bounce : Take(Trajectory(table, position, velocity), 100))
+ *     ...
+ */
+class Trajectory
+{
+public:
+	/**
+	 * Constructor, starting from the given position and velocity.
+	 *
+	 * ITable & table: table to run on.
+	 * Vector & position: initial position of the ball.
+	 * Vector & velocity: initial velocity of the ball.
+	 */
+	Trajectory(ITable & table, const Vector & position, const Vector & velocity);
+	/**
+	 * Destructor, does nothing.
+	 */
+	~Trajectory();
+
+	/**
+	 * Pulls the next record, the starting state on the first call and then
+	 * one bounce per call.
+	 *
+	 * Bounce & bounce: set to the next record.
+	 * return: true, unless a HealthMonitor has stopped the run.
+	 */
+	bool Next(Bounce & bounce);
+
+	/**
+	 * Attaches a monitor to check every following bounce (see
+	 * HealthMonitor). The monitor is not owned, and 0 removes it.
+	 *
+	 * HealthMonitor * monitor: monitor to attach.
+	 */
+	void SetMonitor(HealthMonitor * monitor);
+
+	RangeIterator<Trajectory> begin() { return RangeIterator<Trajectory>(this); }
+	RangeIterator<Trajectory> end() { return RangeIterator<Trajectory>(0); }
+
+private:
+	ITable * fTable;
+	HealthMonitor * fMonitor;
+	// Last record given out.
+	Bounce fLast;
+	bool fStarted;
+};
+
+/**
+ * First n records of a source.
+ */
+template <class Source>
+class TakeRange
+{
+public:
+	TakeRange(const Source & source, long n) :
+		fSource(source), fLeft(n)
+	{}
+
+	bool Next(Bounce & bounce)
+	{
+		if (fLeft <= 0)
+			return false;
+		fLeft--;
+		return fSource.Next(bounce);
+	}
+
+	RangeIterator<TakeRange> begin() { return RangeIterator<TakeRange>(this); }
+	RangeIterator<TakeRange> end() { return RangeIterator<TakeRange>(0); }
+
+private:
+	Source fSource;
+	long fLeft;
+};
+
+/**
+ * Every step'th record of a source, starting with the first.
+ */
+template <class Source>
+class StrideRange
+{
+public:
+	StrideRange(const Source & source, long step) :
+		fSource(source), fStep(step > 0 ? step : 1), fStarted(false)
+	{}
+
+	bool Next(Bounce & bounce)
+	{
+		//Skip step - 1 records between those given out.
+		long skip = fStarted ? fStep : 1;
+		fStarted = true;
+
+		for (long k = 0; k != skip; k++)
+		{
+			if (!fSource.Next(bounce))
+				return false;
+		}
+		return true;
+	}
+
+	RangeIterator<StrideRange> begin() { return RangeIterator<StrideRange>(this); }
+	RangeIterator<StrideRange> end() { return RangeIterator<StrideRange>(0); }
+
+private:
+	Source fSource;
+	long fStep;
+	bool fStarted;
+};
+
+/**
+ * Records of a source for which predicate(bounce) is true. Note on an
+ * unlimited trajectory this only ends if the records it is limited by
+ * (with Take) keep turning up.
+ */
+template <class Source, class Predicate>
+class FilterRange
+{
+public:
+	FilterRange(const Source & source, const Predicate & predicate) :
+		fSource(source), fPredicate(predicate)
+	{}
+
+	bool Next(Bounce & bounce)
+	{
+		while (fSource.Next(bounce))
+		{
+			if (fPredicate(bounce))
+				return true;
+		}
+		return false;
+	}
+
+	RangeIterator<FilterRange> begin() { return RangeIterator<FilterRange>(this); }
+	RangeIterator<FilterRange> end() { return RangeIterator<FilterRange>(0); }
+
+private:
+	Source fSource;
+	Predicate fPredicate;
+};
+
+// Functions to build the adaptors without naming their types.
+template <class Source>
+TakeRange<Source> Take(const Source & source, long n) { return TakeRange<Source>(source, n); }
+
+template <class Source>
+StrideRange<Source> Stride(const Source & source, long step) { return StrideRange<Source>(source, step); }
+
+template <class Source, class Predicate>
+FilterRange<Source, Predicate> Filter(const Source & source, const Predicate & predicate)
+{
+	return FilterRange<Source, Predicate>(source, predicate);
+}
+
+#endif
@@ -5,8 +5,9 @@
  *
  * Main file for the Mathematical billiards simulation.
  * Can run the simulation in three ways: normal plots, chaotic plots and
- * fractal. Outputs to .dat text file, the full name of which is displayed
- * on the screen when outputting.
+ * fractal, plus ensemble analysis modes such as escape statistics. Outputs
+ * to .dat text file, the full name of which is displayed on the screen when
+ * outputting.
  */ 
 
 #include <cstdio>
@@ -15,12 +16,42 @@
 #include <random>
 #include <ctime>
 #include <string>
+#include <vector>
+#include <chrono>
+#include <queue>
+#include <algorithm>
 
 #include "StadiumTable.h"
 #include "EllipseTable.h"
 #include "CircleTable.h"
 #include "RectangleTable.h"
 #include "LorentzTable.h"
+#include "OpenTable.h"
+#include "TableFactory.h"
+#include "Ensemble.h"
+#include "EscapeStatistics.h"
+#include "Parallel.h"
+#include "Scheduler.h"
+#include "Birkhoff.h"
+#include "Raster.h"
+#include "SharedRaster.h"
+#include "TilePyramid.h"
+#include "Lyapunov.h"
+#include "Tangent.h"
+#include "BoxCounter.h"
+#include "Trajectory.h"
+#include "Pipeline.h"
+#include "Observers.h"
+#include "FastEnsemble.h"
+#include "DoubleDouble.h"
+#include "Shadow.h"
+#include "ShadowBatch.h"
+#include "BatchKernel.h"
+#include "CycleDetector.h"
+#include "OrbitSearch.h"
+#include "ErgodicAverages.h"
+#include "PhaseEntropy.h"
+#include "Cloning.h"
 #include "Vector.h"
 
 /**
@@ -157,6 +188,280 @@ void LorentzFractal(int n);
  */
 void LorentzChaos(int n);
 
+/**
+ * EscapeAnalysis asks for the dimensions of the table chosen from the main
+ * menu and for one or more holes in its edge, then runs an ensemble of n
+ * balls with random initial conditions until every ball has escaped (or a
+ * maximum number of bounces is reached). The balls are run in parallel.
+ *
+ * Escape time histograms and survival probabilities, in bounces and in
+ * time, are output to 'esc****out.dat', e.g. 'escstadout.dat' for the
+ * stadium table.
+ *
+ * int choice: main menu table choice (1-5).
+ * int n: number of balls in the ensemble.
+ */
+void EscapeAnalysis(int choice, int n);
+
+/**
+ * PoincareSection runs n trajectories with random initial conditions on the
+ * table chosen from the main menu, and bins every bounce in Birkhoff
+ * coordinates (arc length round the edge against sine of the reflection
+ * angle) into a density raster. The trajectories are run in parallel.
+ *
+ * The bounces can be run in single precision (see FastEnsemble), which is
+ * enough for a picture. The drift from the exact billiard is then printed,
+ * with a warning if it has grown too large.
+ *
+ * Output is written straight to images rather than as text, to
+ * 'poin****out.pgm' (log scaled greyscale) and 'poin****out.raw' (raw 32 bit
+ * floats, top row first).
+ *
+ * int choice: main menu table choice (1-5).
+ * int n: number of trajectories.
+ */
+void PoincareSection(int choice, int n);
+
+/**
+ * DensityImage draws either the ball path (as in the regular plots) or the
+ * fractal mirror-room plot (as in the fractal plots) for the table chosen
+ * from the main menu straight into an image. This replaces writing every
+ * point to a .dat file and plotting it with gnuplot, which is very slow for
+ * large runs. Points are binned in parallel and the image is written log
+ * scaled to 'path****out.pgm' or 'frac****out.pgm', along with the raw
+ * counts in a matching .raw file.
+ *
+ * The fractal plot can also be written as a tile pyramid for zooming, in
+ * the directory 'frac****tiles'. A single tile of the pyramid can then be
+ * redrawn (with further levels beneath it) by only simulating the initial
+ * angles whose rays pass through it.
+ *
+ * int choice: main menu table choice (1-5).
+ * int n: iterations for the path, or repetitions for the fractal.
+ */
+void DensityImage(int choice, int n);
+
+/**
+ * LyapunovAnalysis works out the Lyapunov spectrum of one trajectory on the
+ * table chosen from the main menu, using the linearised bounce map of the
+ * table (see LyapunovSpectrum) instead of two nearby balls as in the chaotic
+ * analysis. The running estimates of the four exponents are written to
+ * 'lyap****out.dat' after each re-orthonormalisation, and the final spectrum
+ * is printed to the screen.
+ *
+ * int choice: main menu table choice (1-5).
+ * int n: number of bounces.
+ */
+void LyapunovAnalysis(int choice, int n);
+
+/**
+ * DivergenceAnalysis is a statistical version of the chaotic analysis. It
+ * runs one reference trajectory on the table chosen from the main menu,
+ * along with a batch of neighbours each started a small distance away in a
+ * random direction in phase space. After every bounce the log of the phase
+ * space distance from each neighbour to the reference is taken, and its
+ * mean, standard deviation and quantiles over the neighbours are written to
+ * 'div****out.dat' in place of the raw coordinates.
+ *
+ * int choice: main menu table choice (1-5).
+ * int n: number of bounces.
+ */
+void DivergenceAnalysis(int choice, int n);
+
+/**
+ * DivergenceHeatmap maps where the table chosen from the main menu is
+ * chaotic and where it is regular. Initial conditions are taken on a grid
+ * in Birkhoff coordinates (arc length s across, sine of the angle to the
+ * normal p up), and for each one a small perturbation is followed with the
+ * linearised bounce map (see Tangent) until it has grown by a given factor,
+ * or for at most n bounces. Chaotic regions show up as few bounces, regular
+ * islands as the full n.
+ *
+ * The grid is split into tiles which are shared between threads. The number
+ * of bounces for each grid point is written to 'heat****out.dat', and as an
+ * image to 'heat****out.pgm' with the raw values in 'heat****out.raw'.
+ *
+ * int choice: main menu table choice (1-5).
+ * int n: maximum number of bounces.
+ */
+void DivergenceHeatmap(int choice, int n);
+
+/**
+ * ParameterSweep runs the table chosen from the main menu for a range of
+ * values of one of its dimensions (e.g. the stadium x size, or the Lorentz
+ * radius), with a number of random initial conditions at each. Every
+ * (parameter, initial condition) pair is a separate work item, and items
+ * are handed out to the threads as they finish the previous one.
+ *
+ * Each run gives the largest Lyapunov exponent (see LyapunovSpectrum), the
+ * mean free path between bounces and the box dimension of its bounces in
+ * Birkhoff coordinates (see BoxCounter). These are averaged over the
+ * initial conditions and written, one line per parameter value, to
+ * 'sweep****out.dat'.
+ *
+ * int choice: main menu table choice (1-5).
+ * int n: bounces per run.
+ */
+void ParameterSweep(int choice, int n);
+
+/**
+ * PipelineAnalysis runs a single trajectory once and hands every bounce to
+ * several analyses at the same time (see Pipeline), rather than running the
+ * table again for each of them. The user picks which observers to attach:
+ * raw output as for the regular plots, free path histogram, Lyapunov
+ * spectrum, box dimension, Poincare section image and escape through holes.
+ *
+ * Each observer prints a summary when the run finishes, followed by the time
+ * spent simulating and in each observer.
+ *
+ * int choice: main menu table choice (1-5).
+ * int n: number of bounces.
+ */
+void PipelineAnalysis(int choice, int n);
+
+/**
+ * PredictabilityHorizon measures how many bounces of a double precision run
+ * on the table chosen from the main menu can be trusted. n balls with random
+ * initial conditions are each run in double alongside a double-double
+ * shadow (see ShadowBatch), in parallel, until they part by more than a
+ * tolerance.
+ *
+ * The fraction of balls still trustworthy after each bounce is written to
+ * 'hor****out.dat', and the spread of the horizons is printed.
+ *
+ * int choice: main menu table choice (1-5).
+ * int n: number of balls.
+ */
+void PredictabilityHorizon(int choice, int n);
+
+/**
+ * OrbitSearch finds periodic orbits of the table chosen from the main menu.
+ * n guesses are spread at random over Birkhoff coordinates (s, p) and each
+ * is refined in parallel with Newton's method on the k-fold bounce map (see
+ * OrbitSearch). Distinct orbits are listed with their period, length and
+ * stability. Parabolic orbits come in continuous families, each listed
+ * once with the number of its members found.
+ *
+ * Every bounce of every orbit is written to 'orbit****out.dat', so the
+ * orbits can be drawn over a Poincare section.
+ *
+ * int choice: main menu table choice (1-5).
+ * int n: number of guesses.
+ */
+void PeriodicOrbitSearch(int choice, int n);
+
+/**
+ * SymbolicAnalysis runs a trajectory on the table chosen from the main menu
+ * and records which wall it hits at each bounce (see SymbolObserver). The
+ * itinerary is written packed into 2 or 3 bits a bounce to
+ * 'sym****out.bin', and the entropy of words of each length up to a
+ * maximum to 'ent****out.dat', with the estimated metric and topological
+ * entropies printed.
+ *
+ * int choice: main menu table choice (1-5).
+ * int n: number of bounces.
+ */
+void SymbolicAnalysis(int choice, int n);
+
+/**
+ * ErgodicAnalysis runs a trajectory on the table chosen from the main menu
+ * until its time averages have settled, rather than for a fixed number of
+ * bounces (see ErgodicAverages). The mean free path and the distributions
+ * of the bounces in arc length and angle are followed with batch mean
+ * errors, and the run stops once they are all within the tolerance, or
+ * after n bounces.
+ *
+ * The bounces needed are printed, and the distributions with their errors
+ * are written to 'erg****out.dat'.
+ *
+ * int choice: main menu table choice (1-5).
+ * int n: most bounces to run.
+ */
+void ErgodicAnalysis(int choice, int n);
+
+/**
+ * CorrelationAnalysis runs a trajectory on the table chosen from the main
+ * menu and works out how fast the free path and the arc length of the
+ * bounces lose their correlation, as it runs (see CorrelationObserver). The
+ * correlation at each lag is written to 'cor****out.dat'.
+ *
+ * int choice: main menu table choice (1-5).
+ * int n: number of bounces.
+ */
+void CorrelationAnalysis(int choice, int n);
+
+/**
+ * MixingAnalysis follows an ensemble of n balls on the table chosen from the
+ * main menu at even steps in time, rather than at collisions (see
+ * Ensemble::Advance). The balls all start at one point, with directions
+ * spread over a small angle, and the table spreads them out over phase
+ * space.
+ *
+ * At each step the coarse grained entropy of the ensemble (see
+ * PhaseEntropy) and the mean squared distance from the start are worked
+ * out in parallel and written to 'step****out.dat', one line per step.
+ *
+ * int choice: main menu table choice (1-5).
+ * int n: number of balls.
+ */
+void MixingAnalysis(int choice, int n);
+
+/**
+ * CloningAnalysis works out the large deviations of the finite time
+ * Lyapunov exponent on the table chosen from the main menu, with a
+ * population of n walkers that are copied or dropped by how much they
+ * stretch (see Cloning). For each bias s in a range it prints the scaled
+ * cumulant generating function psi(s) and the Lyapunov exponent of the
+ * trajectories favoured by that bias, and writes them to 'clone****out.dat'.
+ *
+ * int choice: main menu table choice (1-5).
+ * int n: number of walkers.
+ */
+void CloningAnalysis(int choice, int n);
+
+/**
+ * Asks a yes or no question, repeating until 1 or 0 is entered.
+ *
+ * char * question: question to print.
+ * return: true for yes.
+ */
+bool GetYesNo(const char * question);
+
+/**
+ * InnerPathImage runs the simulation as InnerRun does, but draws the path of
+ * the ball into image instead of writing to a file. The trajectory is
+ * worked out in blocks of bounces, and each block is drawn in parallel.
+ *
+ * ITable & table: billiard table for the simulation.
+ * Vector & position: initial position of the billiard ball.
+ * Vector & velocity: initial velocity of the billiard ball.
+ * int n: number of iterations for the simulation.
+ * Raster & image: image to draw into.
+ */
+void InnerPathImage(ITable & table, Vector & position, Vector & velocity, int n, Raster & image);
+
+/**
+ * InnerFracImage runs the same set of simulations as InnerFrac, in parallel,
+ * and draws the mirror-room points (xVec, yVec) into image instead of
+ * writing them to a file.
+ *
+ * The angles (theta in InnerFrac) can be limited to a smaller range, which
+ * is useful when only part of the image is wanted as all the points from
+ * one angle lie on a ray from the origin at that angle.
+ *
+ * PRE: velocity has argument -pi.
+ *
+ * ITable & table: billiard table for the simulation.
+ * Vector & position: initial position for the billiard ball.
+ * Vector & velocity: initial velocity for the billiard ball.
+ * int n: number of repetitions of the simulation.
+ * Raster & image: image to draw into.
+ * double thetaMin: first angle to simulate.
+ * double thetaMax: angle to stop at (not simulated).
+ */
+void InnerFracImage(ITable & table, const Vector & position, const Vector & velocity, int n, Raster & image,
+	double thetaMin = -M_PI, double thetaMax = M_PI);
+
 /**
  * InnerRun is called iternally by each of the Run functions, and performs the
  * actual simulation once table and initial conditions have been initialised.
@@ -166,13 +471,21 @@ void LorentzChaos(int n);
  * Once this function has run the Vector position will contain the final
  * position of the ball, and velocity conatins its final velocity.
  *
+ * Every bounce is checked by a HealthMonitor, which may stop the run early
+ * (see HealthMonitor::DefaultPolicy). The checks are summarised on screen.
+ *
+ * With a CycleDetector the run also stops once the ball is found to be on a
+ * periodic orbit, as the rest of the file would only repeat it. A comment
+ * line giving the period is written at the end of the file.
+ *
  * ITable & table: billiard table for the simulation.
  * Vector & position: initial position of the billiard ball.
  * Vector & velocity: initial velocity of the billiard ball.
  * int n: number of iterations for the simulation.
  * FILE * file: file stream to write to.
+ * CycleDetector * cycles: detector to stop periodic orbits with, or 0.
  */
-void InnerRun(ITable & table, Vector & position, Vector & velocity, int n, FILE * file);
+void InnerRun(ITable & table, Vector & position, Vector & velocity, int n, FILE * file, CycleDetector * cycles);
 
 /**
  * InnerFrac is called iternally by each of the Fractal functions. It takes in
@@ -192,6 +505,37 @@ void InnerRun(ITable & table, Vector & position, Vector & velocity, int n, FILE
  */
 void InnerFrac(ITable & table, Vector & position, Vector & velocity, int n, FILE * file);
 
+/**
+ * InnerFracAdaptive produces the same output as InnerFrac, but rather than
+ * spacing the n initial angles evenly it starts with a coarse, even grid and
+ * then repeatedly splits the angle intervals where the final path length or
+ * the final wall hit changes most sharply. This puts the samples on the
+ * fine structure of the fractal instead of the smooth regions between.
+ *
+ * Each refinement round splits a batch of intervals, simulated in parallel.
+ * Runs are written in the order they are simulated, so the angle column is
+ * not sorted.
+ *
+ * PRE: velocity has argument -pi.
+ *
+ * ITable & table: billiard table for the simulation.
+ * Vector & position: initial position for the billiard ball.
+ * Vector & velocity: initial velocity for the billiard ball.
+ * int n: total number of initial velocity angles to simulate.
+ * int coarse: number of evenly spaced angles to start from.
+ * FILE * file: file stream to write to.
+ */
+void InnerFracAdaptive(ITable & table, const Vector & position, const Vector & velocity, int n, int coarse, FILE * file);
+
+/**
+ * Asks whether the fractal should use adaptive angle sampling, and if so how
+ * coarse the starting grid should be.
+ *
+ * int & coarse: set to the number of angles in the starting grid.
+ * return: true for adaptive sampling (InnerFracAdaptive).
+ */
+bool GetAdaptive(int & coarse);
+
 /**
  * InnerChaos runs the chaotic simulation internally. Unlike the other two
  * inner functions this takes two sets of initial conditions, and runs the
@@ -211,6 +555,65 @@ void InnerFrac(ITable & table, Vector & position, Vector & velocity, int n, FILE
  */
 void InnerChaos(ITable & table, Vector & position1, Vector & position2, Vector & velocity1, Vector & velocity2, int n, FILE * file);
 
+/**
+ * InnerRunPrecise produces the same output as InnerRun, but carries the ball
+ * in double-double precision (about 32 digits, see DoubleDouble) through a
+ * TableKernel. Only the output is rounded to double, so chaotic trajectories
+ * stay accurate for about twice as many bounces.
+ *
+ * ITable & table: billiard table, used only for the angle of incidence.
+ * int type: table type, as for CreateTable.
+ * double params[]: table geometry, as for CreateTable.
+ * Vector & position: initial position, set to the final position.
+ * Vector & velocity: initial velocity, set to the final velocity.
+ * int n: number of iterations for the simulation.
+ * FILE * file: file stream to write to.
+ */
+void InnerRunPrecise(ITable & table, int type, double params[], Vector & position, Vector & velocity, int n, FILE * file);
+
+/**
+ * InnerChaosPrecise produces the same output as InnerChaos, with both balls
+ * carried in double-double precision as for InnerRunPrecise. The two balls
+ * are run together through a BatchKernel.
+ */
+void InnerChaosPrecise(ITable & table, int type, double params[], Vector & position1, Vector & position2, Vector & velocity1, Vector & velocity2, int n, FILE * file);
+
+/**
+ * Asks whether a regular run should stop once the ball is found to be on a
+ * periodic orbit, and if so how close the bounces must come back.
+ *
+ * ITable & table: table being run, for the length of its edge.
+ * CycleDetector & cycles: set up to detect the orbits, if asked for.
+ * return: true if periodic orbits should be stopped.
+ */
+bool GetCycleDetection(ITable & table, CycleDetector & cycles);
+
+/**
+ * Asks which precision the run should use: double, double-double, or double
+ * stopped at its predictability horizon (see TrustedBounces).
+ *
+ * double & tolerance: set to the tolerance for the horizon, if asked for.
+ * return: 0 for double, 1 for double-double (InnerRunPrecise or
+ * InnerChaosPrecise), 2 for double stopped at the horizon.
+ */
+int GetPrecision(double & tolerance);
+
+/**
+ * Finds how many bounces of a double precision run can be trusted, by
+ * running it against a double-double shadow (see Shadow) until they part by
+ * more than tolerance. Prints the result.
+ *
+ * ITable & table: billiard table for the double run.
+ * int type: table type, as for CreateTable.
+ * double params[]: table geometry, as for CreateTable.
+ * Vector & position: initial position of the ball.
+ * Vector & velocity: initial velocity of the ball.
+ * int n: most bounces wanted.
+ * double tolerance: largest trusted phase space distance.
+ * return: trusted number of bounces, at most n.
+ */
+int TrustedBounces(ITable & table, int type, double params[], const Vector & position, const Vector & velocity, int n, double tolerance);
+
 /**
  * Initialises vector position and velocity of the billiard ball, by asking
  * for user input. initial and velocity will contain the values once the
@@ -221,6 +624,54 @@ void InnerChaos(ITable & table, Vector & position1, Vector & position2, Vector &
  */
 void GetArgs(Vector & initial, Vector & velocity);
 
+/**
+ * Asks whether to use random or user-input initial conditions, as the Run
+ * functions do, and then sets them with RandomArgs or GetArgs.
+ *
+ * Vector & initial: Vector to store initial position in.
+ * Vector & velocity: Vector to store initial velocity in.
+ * int type: table type, as for RandomArgs.
+ * double params[]: table geometry, as for RandomArgs.
+ */
+void ChooseArgs(Vector & initial, Vector & velocity, int type, double params[]);
+
+/**
+ * Asks for the dimensions of the table chosen from the main menu, in the
+ * same way as the Run functions, and creates the table.
+ *
+ * int choice: main menu table choice (1-5).
+ * int & type: set to the table type used by RandomArgs and CreateTable.
+ * double params[]: filled with the table geometry, needs room for 3 values.
+ * return: new table, which the caller must delete.
+ */
+ITable * GetTable(int choice, int & type, double params[]);
+
+/**
+ * Short name of the table chosen from the main menu, as used in output file
+ * names (e.g. 'stad' for the stadium).
+ *
+ * int choice: main menu table choice (1-5).
+ * return: name of the table.
+ */
+const char * TableName(int choice);
+
+/**
+ * Prints how evenly the work of the last parallel run was spread over the
+ * threads (see Scheduler::WriteStatistics).
+ */
+void PrintLoadBalance();
+
+/**
+ * Finds the size of a table from its type and geometry, as used by
+ * RandomArgs. Every table lies within -x to x and -y to y.
+ *
+ * int type: integer 1-5 specifying the type of table.
+ * double params[]: array specifying the geometry of the table.
+ * double & x: set to the largest x coordinate on the table.
+ * double & y: set to the largest y coordinate on the table.
+ */
+void TableExtent(int type, double params[], double & x, double & y);
+
 /**
  * Function to randomise initial conditions for a given table type with
  * supplied parameters. initial and velocity will contain the values once the
@@ -240,6 +691,15 @@ void GetArgs(Vector & initial, Vector & velocity);
  */
 void RandomArgs(Vector & initial, Vector & velocity, int type, double params[]);
 
+/**
+ * As above, but drawing from an existing random engine. Use this when
+ * generating many initial conditions, as the above reseeds from the clock on
+ * every call.
+ *
+ * std::default_random_engine & engine: random engine to draw from.
+ */
+void RandomArgs(Vector & initial, Vector & velocity, int type, double params[], std::default_random_engine & engine);
+
 /**
  * Prints help messages!
  */
@@ -283,16 +743,111 @@ int main()
 		if (choice != 6)
 		{		
 			printf("\n# Simulation Type: #\n");
-			printf("Please enter 0 for regular plots, 1 for fractal plots or 2 for chaotic behaviour analysis: ");
-			while (!(std::cin >> secondChoice) || secondChoice < 0 || secondChoice > 2)
+			printf("(0) Regular plots\n");
+			printf("(1) Fractal plots\n");
+			printf("(2) Chaotic behaviour analysis\n");
+			printf("(3) Escape statistics (open table)\n");
+			printf("(4) Poincare section density image\n");
+			printf("(5) Path or fractal density image\n");
+			printf("(6) Lyapunov spectrum (tangent map)\n");
+			printf("(7) Divergence statistics (many neighbours)\n");
+			printf("(8) Divergence time heatmap\n");
+			printf("(9) Parameter sweep\n");
+			printf("(10) Combined analysis (one pass, several observers)\n");
+			printf("(11) Predictability horizon (double against double-double)\n");
+			printf("(12) Periodic orbit search (Newton)\n");
+			printf("(13) Symbolic dynamics (itinerary and entropies)\n");
+			printf("(14) Ergodic averages (run until converged)\n");
+			printf("(15) Decay of correlations\n");
+			printf("(16) Mixing of an ensemble (even time steps)\n");
+			printf("(17) Large deviations of chaos (cloning)\n");
+			printf("Please enter a choice: ");
+			while (!(std::cin >> secondChoice) || secondChoice < 0 || secondChoice > 17)
 			{
 				printf("Enter a valid choice: ");
 				std::cin.clear();
 				std::cin.ignore();
 			}
 
-			printf("\n# Number of Iterations: #\nPlease enter number of iterations: ");
+			printf("\n# Number of Iterations: #\nPlease enter number of iterations (number of balls for ensemble modes): ");
 			std::cin >> n;
+
+			//The analysis modes work the same way for every table.
+			if (secondChoice == 3)
+			{
+				EscapeAnalysis(choice, n);
+				continue;
+			}
+			else if (secondChoice == 4)
+			{
+				PoincareSection(choice, n);
+				continue;
+			}
+			else if (secondChoice == 5)
+			{
+				DensityImage(choice, n);
+				continue;
+			}
+			else if (secondChoice == 6)
+			{
+				LyapunovAnalysis(choice, n);
+				continue;
+			}
+			else if (secondChoice == 7)
+			{
+				DivergenceAnalysis(choice, n);
+				continue;
+			}
+			else if (secondChoice == 8)
+			{
+				DivergenceHeatmap(choice, n);
+				continue;
+			}
+			else if (secondChoice == 9)
+			{
+				ParameterSweep(choice, n);
+				continue;
+			}
+			else if (secondChoice == 10)
+			{
+				PipelineAnalysis(choice, n);
+				continue;
+			}
+			else if (secondChoice == 11)
+			{
+				PredictabilityHorizon(choice, n);
+				continue;
+			}
+			else if (secondChoice == 12)
+			{
+				PeriodicOrbitSearch(choice, n);
+				continue;
+			}
+			else if (secondChoice == 13)
+			{
+				SymbolicAnalysis(choice, n);
+				continue;
+			}
+			else if (secondChoice == 14)
+			{
+				ErgodicAnalysis(choice, n);
+				continue;
+			}
+			else if (secondChoice == 15)
+			{
+				CorrelationAnalysis(choice, n);
+				continue;
+			}
+			else if (secondChoice == 16)
+			{
+				MixingAnalysis(choice, n);
+				continue;
+			}
+			else if (secondChoice == 17)
+			{
+				CloningAnalysis(choice, n);
+				continue;
+			}
 		}
 
 		//Run specified option.
@@ -386,6 +941,17 @@ void RunStadium(int n)
 		GetArgs(initial, velocity);
 	}
 
+	//Table geometry for the double-double kernel, as for CreateTable.
+	double geometry[] = {x, y};
+	double tolerance;
+	int precision = GetPrecision(tolerance);
+
+	if (precision == 2)
+		n = TrustedBounces(table, 4, geometry, initial, velocity, n, tolerance);
+
+	CycleDetector cycles;
+	bool detect = precision != 1 && GetCycleDetection(table, cycles);
+
 	FILE * file;
 
 	file = fopen("stadout.dat", "w");
@@ -393,7 +959,10 @@ void RunStadium(int n)
 	printf("\nWriting to 'stadout.dat'...\n");
 
 	//Call internal run function.
-	InnerRun(table, initial, velocity, n, file);
+	if (precision == 1)
+		InnerRunPrecise(table, 4, geometry, initial, velocity, n, file);
+	else
+		InnerRun(table, initial, velocity, n, file, detect ? &cycles : 0);
 
 	fclose(file);
 
@@ -425,6 +994,16 @@ void StadiumChaos(int n)
 	//Need two sets of initial conditions for this analysis.
 	GetArgs(initial2, velocity2);
 
+	//Table geometry for the double-double kernel, as for CreateTable.
+	double geometry[] = {x, y};
+	double tolerance;
+	int precision = GetPrecision(tolerance);
+
+	//Stop where either ball stops being trustworthy.
+	if (precision == 2)
+		n = std::min(TrustedBounces(table, 4, geometry, initial1, velocity1, n, tolerance),
+			TrustedBounces(table, 4, geometry, initial2, velocity2, n, tolerance));
+
 	FILE * file;
 
 	file = fopen("chaostadout.dat", "w");
@@ -432,7 +1011,10 @@ void StadiumChaos(int n)
 	printf("\nWriting to 'chaostadout.dat'...\n");
 
 	//Call internal chaos function.
-	InnerChaos(table, initial1, initial2, velocity1, velocity2, n, file);
+	if (precision == 1)
+		InnerChaosPrecise(table, 4, geometry, initial1, initial2, velocity1, velocity2, n, file);
+	else
+		InnerChaos(table, initial1, initial2, velocity1, velocity2, n, file);
 
 	fclose(file);
 
@@ -468,12 +1050,19 @@ void StadiumFractal(int n)
 	//-pi.
 	Vector velocity(-1, 0);
 
+	//Choose evenly spaced or adaptive initial angles.
+	int coarse;
+	bool adaptive = GetAdaptive(coarse);
+
 	FILE * file;
 	file = fopen("fracstadout.dat", "w");
 	printf("Writing to file fracstadout.dat...\n");
 
 	//Call inner fractal method.
-	InnerFrac(table, position, velocity, n, file);
+	if (adaptive)
+		InnerFracAdaptive(table, position, velocity, n, coarse, file);
+	else
+		InnerFrac(table, position, velocity, n, file);
 
 	printf("Done!\n");
 	fclose(file); 
@@ -516,6 +1105,17 @@ void RunEllipse(int n)
 		GetArgs(initial, velocity);
 	}
 
+	//Table geometry for the double-double kernel, as for CreateTable.
+	double geometry[] = {r, x, y};
+	double tolerance;
+	int precision = GetPrecision(tolerance);
+
+	if (precision == 2)
+		n = TrustedBounces(table, 2, geometry, initial, velocity, n, tolerance);
+
+	CycleDetector cycles;
+	bool detect = precision != 1 && GetCycleDetection(table, cycles);
+
 	FILE * file;
 
 	file = fopen("elipout.dat", "w");
@@ -523,7 +1123,10 @@ void RunEllipse(int n)
 	printf("\nWriting to 'elipout.dat'...\n");
 
 	//Call inner method.
-	InnerRun(table, initial, velocity, n, file);
+	if (precision == 1)
+		InnerRunPrecise(table, 2, geometry, initial, velocity, n, file);
+	else
+		InnerRun(table, initial, velocity, n, file, detect ? &cycles : 0);
 
 	fclose(file);
 
@@ -558,6 +1161,16 @@ void EllipticalChaos(int n)
 	//Need two sets of initial conditions for this analysis.
 	GetArgs(initial2, velocity2);
 
+	//Table geometry for the double-double kernel, as for CreateTable.
+	double geometry[] = {r, x, y};
+	double tolerance;
+	int precision = GetPrecision(tolerance);
+
+	//Stop where either ball stops being trustworthy.
+	if (precision == 2)
+		n = std::min(TrustedBounces(table, 2, geometry, initial1, velocity1, n, tolerance),
+			TrustedBounces(table, 2, geometry, initial2, velocity2, n, tolerance));
+
 	FILE * file;
 
 	file = fopen("chaoelipout.dat", "w");
@@ -565,7 +1178,10 @@ void EllipticalChaos(int n)
 	printf("\nWriting to 'chaoelipout.dat'...\n");
 
 	//Call internal chaos function.
-	InnerChaos(table, initial1, initial2, velocity1, velocity2, n, file);
+	if (precision == 1)
+		InnerChaosPrecise(table, 2, geometry, initial1, initial2, velocity1, velocity2, n, file);
+	else
+		InnerChaos(table, initial1, initial2, velocity1, velocity2, n, file);
 
 	fclose(file);
 
@@ -598,12 +1214,19 @@ void EllipticalFractal(int n)
 	//Initial velocity.
 	Vector velocity(-1, 0);
 
+	//Choose evenly spaced or adaptive initial angles.
+	int coarse;
+	bool adaptive = GetAdaptive(coarse);
+
 	FILE * file;
 	file = fopen("fracelipout.dat", "w");
 	printf("Writing to file fracelipout.dat...\n");
 
 	//Call inner method.
-	InnerFrac(table, position, velocity, n, file);
+	if (adaptive)
+		InnerFracAdaptive(table, position, velocity, n, coarse, file);
+	else
+		InnerFrac(table, position, velocity, n, file);
 
 	printf("Done!\n");
 	fclose(file); 
@@ -642,6 +1265,17 @@ void RunCircle(int n)
 		GetArgs(initial, velocity);
 	}
 
+	//Table geometry for the double-double kernel, as for CreateTable.
+	double geometry[] = {r};
+	double tolerance;
+	int precision = GetPrecision(tolerance);
+
+	if (precision == 2)
+		n = TrustedBounces(table, 1, geometry, initial, velocity, n, tolerance);
+
+	CycleDetector cycles;
+	bool detect = precision != 1 && GetCycleDetection(table, cycles);
+
 	FILE * file;
 
 	file = fopen("circout.dat", "w");
@@ -649,7 +1283,10 @@ void RunCircle(int n)
 	printf("\nWriting to 'circout.dat'...\n");
 
 	//Call inner method.
-	InnerRun(table, initial, velocity, n, file);
+	if (precision == 1)
+		InnerRunPrecise(table, 1, geometry, initial, velocity, n, file);
+	else
+		InnerRun(table, initial, velocity, n, file, detect ? &cycles : 0);
 	
 	fclose(file);
 
@@ -678,6 +1315,16 @@ void CircularChaos(int n)
 	//Need two sets of initial conditions for this analysis.
 	GetArgs(initial2, velocity2);
 
+	//Table geometry for the double-double kernel, as for CreateTable.
+	double geometry[] = {r};
+	double tolerance;
+	int precision = GetPrecision(tolerance);
+
+	//Stop where either ball stops being trustworthy.
+	if (precision == 2)
+		n = std::min(TrustedBounces(table, 1, geometry, initial1, velocity1, n, tolerance),
+			TrustedBounces(table, 1, geometry, initial2, velocity2, n, tolerance));
+
 	FILE * file;
 
 	file = fopen("chaocircout.dat", "w");
@@ -685,7 +1332,10 @@ void CircularChaos(int n)
 	printf("\nWriting to 'chaocircout.dat'...\n");
 
 	//Call internal chaos function.
-	InnerChaos(table, initial1, initial2, velocity1, velocity2, n, file);
+	if (precision == 1)
+		InnerChaosPrecise(table, 1, geometry, initial1, initial2, velocity1, velocity2, n, file);
+	else
+		InnerChaos(table, initial1, initial2, velocity1, velocity2, n, file);
 
 	fclose(file);
 
@@ -712,11 +1362,18 @@ void CircularFractal(int n)
 
 	Vector velocity(-1, 0);
 
+	//Choose evenly spaced or adaptive initial angles.
+	int coarse;
+	bool adaptive = GetAdaptive(coarse);
+
 	FILE * file;
 	file = fopen("fraccircout.dat", "w");
 	printf("Writing to file fraccircout.dat...\n");
 
-	InnerFrac(table, position, velocity, n, file);
+	if (adaptive)
+		InnerFracAdaptive(table, position, velocity, n, coarse, file);
+	else
+		InnerFrac(table, position, velocity, n, file);
 
 	printf("Done!\n");
 	fclose(file); 
@@ -757,13 +1414,27 @@ void RunRectangle(int n)
 	}
 
 
+	//Table geometry for the double-double kernel, as for CreateTable.
+	double geometry[] = {x, y};
+	double tolerance;
+	int precision = GetPrecision(tolerance);
+
+	if (precision == 2)
+		n = TrustedBounces(table, 3, geometry, initial, velocity, n, tolerance);
+
+	CycleDetector cycles;
+	bool detect = precision != 1 && GetCycleDetection(table, cycles);
+
 	FILE * file;
 
 	file = fopen("rectout.dat", "w");
 
 	printf("\nWriting to 'rectout.dat'...\n");
 
-	InnerRun(table, initial, velocity, n, file);
+	if (precision == 1)
+		InnerRunPrecise(table, 3, geometry, initial, velocity, n, file);
+	else
+		InnerRun(table, initial, velocity, n, file, detect ? &cycles : 0);
 	
 	fclose(file);
 
@@ -794,6 +1465,16 @@ void RectangularChaos(int n)
 	//Need two sets of initial conditions for this analysis.
 	GetArgs(initial2, velocity2);
 
+	//Table geometry for the double-double kernel, as for CreateTable.
+	double geometry[] = {x, y};
+	double tolerance;
+	int precision = GetPrecision(tolerance);
+
+	//Stop where either ball stops being trustworthy.
+	if (precision == 2)
+		n = std::min(TrustedBounces(table, 3, geometry, initial1, velocity1, n, tolerance),
+			TrustedBounces(table, 3, geometry, initial2, velocity2, n, tolerance));
+
 	FILE * file;
 
 	file = fopen("chaorectout.dat", "w");
@@ -801,7 +1482,10 @@ void RectangularChaos(int n)
 	printf("\nWriting to 'chaorectout.dat'...\n");
 
 	//Call internal chaos function.
-	InnerChaos(table, initial1, initial2, velocity1, velocity2, n, file);
+	if (precision == 1)
+		InnerChaosPrecise(table, 3, geometry, initial1, initial2, velocity1, velocity2, n, file);
+	else
+		InnerChaos(table, initial1, initial2, velocity1, velocity2, n, file);
 
 	fclose(file);
 
@@ -830,11 +1514,18 @@ void RectangularFractal(int n)
 
 	Vector velocity(-1, 0);
 
+	//Choose evenly spaced or adaptive initial angles.
+	int coarse;
+	bool adaptive = GetAdaptive(coarse);
+
 	FILE * file;
 	file = fopen("fracrectout.dat", "w");
 	printf("Writing to file fracrectout.dat...\n");
 
-	InnerFrac(table, position, velocity, n, file);
+	if (adaptive)
+		InnerFracAdaptive(table, position, velocity, n, coarse, file);
+	else
+		InnerFrac(table, position, velocity, n, file);
 
 	printf("Done!\n");
 	fclose(file); 
@@ -883,13 +1574,27 @@ void RunLorentz(int n)
 
 	//GetArgs(initial, velocity);
 
+	//Table geometry for the double-double kernel, as for CreateTable.
+	double geometry[] = {x, y, r};
+	double tolerance;
+	int precision = GetPrecision(tolerance);
+
+	if (precision == 2)
+		n = TrustedBounces(table, 5, geometry, initial, velocity, n, tolerance);
+
+	CycleDetector cycles;
+	bool detect = precision != 1 && GetCycleDetection(table, cycles);
+
 	FILE * file;
 
 	file = fopen("loreout.dat", "w");
 
 	printf("\nWriting to 'loreout.dat'...\n");
 
-	InnerRun(table, initial, velocity, n, file);
+	if (precision == 1)
+		InnerRunPrecise(table, 5, geometry, initial, velocity, n, file);
+	else
+		InnerRun(table, initial, velocity, n, file, detect ? &cycles : 0);
 
 	fclose(file);
 
@@ -921,6 +1626,16 @@ void LorentzChaos(int n)
 	//Need two sets of initial conditions for this analysis.
 	GetArgs(initial2, velocity2);
 
+	//Table geometry for the double-double kernel, as for CreateTable.
+	double geometry[] = {x, y, r};
+	double tolerance;
+	int precision = GetPrecision(tolerance);
+
+	//Stop where either ball stops being trustworthy.
+	if (precision == 2)
+		n = std::min(TrustedBounces(table, 5, geometry, initial1, velocity1, n, tolerance),
+			TrustedBounces(table, 5, geometry, initial2, velocity2, n, tolerance));
+
 	FILE * file;
 
 	file = fopen("chaoloreout.dat", "w");
@@ -928,7 +1643,10 @@ void LorentzChaos(int n)
 	printf("\nWriting to 'chaoloreout.dat'...\n");
 
 	//Call internal chaos function.
-	InnerChaos(table, initial1, initial2, velocity1, velocity2, n, file);
+	if (precision == 1)
+		InnerChaosPrecise(table, 5, geometry, initial1, initial2, velocity1, velocity2, n, file);
+	else
+		InnerChaos(table, initial1, initial2, velocity1, velocity2, n, file);
 
 	fclose(file);
 
@@ -959,66 +1677,1581 @@ void LorentzFractal(int n)
 
 	Vector velocity(-1, 0);
 
+	//Choose evenly spaced or adaptive initial angles.
+	int coarse;
+	bool adaptive = GetAdaptive(coarse);
+
 	FILE * file;
 	file = fopen("fracloreout.dat", "w");
 	printf("Writing to file fracloreout.dat...\n");
 
-	InnerFrac(table, position, velocity, n, file);
+	if (adaptive)
+		InnerFracAdaptive(table, position, velocity, n, coarse, file);
+	else
+		InnerFrac(table, position, velocity, n, file);
 
 	printf("Done!\n");
 	fclose(file); 
 }
 
-void InnerRun(ITable & table, Vector & position, Vector & velocity, int n, FILE * file)
+void EscapeAnalysis(int choice, int n)
 {
-	//Get initial angle.
-	double angle = velocity.Arg();
+	int type;
+	double params[3];
 
-	//Print headers to file.
-	fprintf(file, "%-10s%-20s%-20s%-20s%-20s%-20s%-20s%-20s%-20s%-20s\n", "i", "x", "y", "mp", "pa", "a", "vx", "vy", "mv", "va");
+	ITable * table = GetTable(choice, type, params);
 
-	//For specified number of iterations:
-	for (int i = 0; i != n; i++)
+	//Open table wraps the chosen one.
+	OpenTable open(table);
+
+	int holes;
+	printf("\n# Holes: #\nThe table edge is measured by arc length from 0 to %f, see help\n", table->BoundaryLength());
+	printf("for where it starts. Please enter number of holes: ");
+	std::cin >> holes;
+
+	for (int i = 0; i != holes; i++)
 	{
-		//Print current status.
-		fprintf(file, "%-10i%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f\n", 
-			i, position.fX, position.fY, position.Mod(), position.Arg(),
-			angle, velocity.fX, velocity.fY, velocity.Mod(), velocity.Arg());
-		//Find next position.
-		position = table.CollisionPoint(position, velocity);
-		//Find angle between table wall and ball trajectory.
-		angle = std::fmod(table.AngleIncidence(position, velocity), 2*M_PI);
-		//Find velocity after collision.
-		velocity = table.ReflectVector(position, velocity);
+		double start, end;
+		printf("Hole %i start: ", i + 1);
+		std::cin >> start;
+		printf("Hole %i end: ", i + 1);
+		std::cin >> end;
+		open.AddHole(start, end);
 	}
-}
-
-void InnerFrac(ITable & table, Vector & position, Vector & velocity, int n, FILE * file)
-{
-	//Initialise varibales and temporary variables.
-	double tLength, pLength = 0, xLength = 0, yLength = 0, theta;
-	//pLength, xLength and yLength are the important data to output,
-	//tLength and theta are temporary useful variables.
 
-	//Store initial conditions, as they must be returned to after each run.
-	Vector initial = position;
-	Vector vInitial = velocity;
+	int maxBounces;
+	double timeBin;
+	printf("\n# Run Length: #\nPlease enter maximum bounces per ball: ");
+	std::cin >> maxBounces;
+	printf("Please enter time bin width for escape time histogram: ");
+	std::cin >> timeBin;
+
+	//Random starting positions, with random directions and speed 1 so
+	//that time is the same as path length.
+	std::default_random_engine engine;
+	engine.seed(std::time(0));
+	std::uniform_real_distribution<double> rangeA(-M_PI, M_PI);
+
+	Ensemble ensemble(n);
+	Vector initial, velocity;
+
+	for (int i = 0; i != n; i++)
+	{
+		RandomArgs(initial, velocity, type, params, engine);
+		double angle = rangeA(engine);
+		ensemble.Add(initial, Vector(std::cos(angle), std::sin(angle)));
+	}
+
+	EscapeStatistics statistics(maxBounces, timeBin);
+
+	printf("\nRunning %i balls on %i threads...\n", n, ThreadCount());
+	Scheduler::Global().ResetStatistics();
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	ensemble.Escape(open, maxBounces, statistics);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	//Total work done, for throughput.
+	double bounces = 0;
+	for (int i = 0; i != ensemble.GetSize(); i++)
+		bounces += ensemble.GetBounces(i);
+
+	printf("Escaped: %li, still on table: %li\n", statistics.GetEscaped(), statistics.GetCensored());
+	printf("Mean escape after %f bounces, time %f\n", statistics.GetMeanBounces(), statistics.GetMeanTime());
+	printf("%.0f bounces in %f s (%.3g bounces/s)\n", bounces, seconds, bounces / seconds);
+
+	std::string name = std::string("esc") + TableName(choice) + "out.dat";
+
+	FILE * file;
+
+	file = fopen(name.c_str(), "w");
+
+	printf("\nWriting to '%s'...\n", name.c_str());
+
+	statistics.Write(file);
+
+	fclose(file);
+
+	PrintLoadBalance();
+
+	printf("Done!\n");
+
+	delete table;
+
+	return;
+}
+
+void PoincareSection(int choice, int n)
+{
+	int type;
+	double params[3];
+
+	ITable * table = GetTable(choice, type, params);
+
+	int bounces, width, height;
+	printf("\n# Run Length: #\nPlease enter bounces per trajectory: ");
+	std::cin >> bounces;
+	printf("\n# Image Size: #\nPlease enter image width: ");
+	std::cin >> width;
+	printf("Please enter image height: ");
+	std::cin >> height;
+
+	bool single = GetYesNo("\n# Precision: #\nEnter 1 for single precision (faster, with drift check), 0 for double: ");
+
+	//Initial conditions generated up front so the run doesn't depend on
+	//how trajectories are shared between threads.
+	std::default_random_engine engine;
+	engine.seed(std::time(0));
+
+	std::vector<Vector> initial(n), velocity(n);
+	for (int i = 0; i != n; i++)
+		RandomArgs(initial[i], velocity[i], type, params, engine);
+
+	//s runs along the x axis of the image, p up the y axis.
+	Raster image(width, height, 0, table->BoundaryLength(), -1, 1);
+	SharedRaster shared(image, ThreadCount());
+
+	printf("\nRunning %i trajectories on %i threads...\n", n, ThreadCount());
+	Scheduler::Global().ResetStatistics();
+
+	if (single)
+	{
+		//Bounces run in float, only the Birkhoff coordinates in double.
+		FastEnsemble<float> ensemble(n);
+		for (int i = 0; i != n; i++)
+			ensemble.Add(initial[i], velocity[i]);
+
+		DriftMonitor monitor;
+
+		ensemble.Run(TableKernel<float>(type, params), bounces, monitor,
+			[&](int ball, int bounce, const TVector<float> & position, const TVector<float> & v, int thread)
+		{
+			double s, p;
+			BirkhoffCoordinates(*table, position.ToVector(), v.ToVector(), s, p);
+			shared.Add(s, p, thread);
+		});
+
+		monitor.Write(stdout);
+	}
+	else
+	{
+		ParallelFor(n, [&](int begin, int end, int thread)
+		{
+			double s, p;
+
+			for (int i = begin; i != end; i++)
+			{
+				Vector position = initial[i];
+				Vector v = velocity[i];
+
+				for (int j = 0; j != bounces; j++)
+				{
+					position = table->CollisionPoint(position, v);
+					v = table->ReflectVector(position, v);
+
+					BirkhoffCoordinates(*table, position, v, s, p);
+					shared.Add(s, p, thread);
+				}
+			}
+		});
+	}
+
+	shared.Flush();
+
+	std::string name = std::string("poin") + TableName(choice) + "out";
+
+	printf("Writing to '%s.pgm' and '%s.raw' (%i x %i floats)...\n", name.c_str(), name.c_str(), width, height);
+
+	image.WritePGM((name + ".pgm").c_str());
+	image.WriteRaw((name + ".raw").c_str());
+
+	PrintLoadBalance();
+
+	printf("Done!\n");
+
+	delete table;
+
+	return;
+}
+
+void DensityImage(int choice, int n)
+{
+	int type;
+	double params[3];
+
+	ITable * table = GetTable(choice, type, params);
+
+	double xSize, ySize;
+	TableExtent(type, params, xSize, ySize);
+
+	int fractal;
+	printf("\n# Image Type: #\nEnter 0 for the ball path, 1 for the fractal plot or 2 to zoom into a fractal\ntile: ");
+	while (!(std::cin >> fractal) || fractal < 0 || fractal > 2)
+	{
+		std::cin.clear();
+		std::cin.ignore();
+		printf("Please enter a valid choice: ");
+	}
+
+	Vector initial, velocity;
+	double range = 0;
+
+	if (fractal)
+	{
+		double offset;
+		printf("\n# Offset: #\nPlease enter offset from table edge (rec ~ 0.00001): ");
+		std::cin >> offset;
+		printf("Please enter plot range (gnuplot script uses 20): ");
+		std::cin >> range;
+
+		//As in the fractal functions, start next to the right hand wall.
+		initial = Vector(xSize - offset, 0);
+		velocity = Vector(-1, 0);
+	}
+	else
+	{
+		ChooseArgs(initial, velocity, type, params);
+	}
+
+	//Tiles are always 256 pixels, and the top tile covers the plot range.
+	TilePyramid pyramid(256, -range, range, -range, range);
+	std::string tiles = std::string("frac") + TableName(choice) + "tiles";
+	int width = 0, levels = 0, z = 0, x = 0, y = 0;
+
+	if (fractal == 1)
+	{
+		printf("\n# Tile Pyramid: #\nPlease enter levels of tile pyramid (0 for none): ");
+		std::cin >> levels;
+	}
+	else if (fractal == 2)
+	{
+		printf("\n# Tile: #\nPlease enter tile level: ");
+		std::cin >> z;
+		printf("Please enter tile x: ");
+		std::cin >> x;
+		printf("Please enter tile y: ");
+		std::cin >> y;
+		printf("Please enter levels to write from this tile: ");
+		std::cin >> levels;
+	}
+
+	if (levels < 1)
+	{
+		printf("\n# Image Size: #\nPlease enter image width: ");
+		std::cin >> width;
+	}
+
+	std::string name = std::string(fractal ? "frac" : "path") + TableName(choice) + "out";
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	if (fractal == 2)
+	{
+		//Only simulate the angles which reach the tile.
+		double thetaMin, thetaMax;
+		pyramid.TileAngles(z, x, y, thetaMin, thetaMax);
+		printf("\nSimulating angles %f to %f (%f of the full sweep)...\n", thetaMin, thetaMax, (thetaMax - thetaMin) / (2*M_PI));
+
+		Raster image = pyramid.TileRaster(z, x, y, levels);
+		InnerFracImage(*table, initial, velocity, n, image, thetaMin, thetaMax);
+		printf("Wrote %i tiles to '%s'.\n", pyramid.Write(image, tiles.c_str(), z, x, y, levels), tiles.c_str());
+	}
+	else if (fractal)
+	{
+		Raster image = levels > 0 ? pyramid.TileRaster(0, 0, 0, levels) : Raster(width, width, -range, range, -range, range);
+		InnerFracImage(*table, initial, velocity, n, image);
+		image.WritePGM((name + ".pgm").c_str(), 0.999);
+		image.WriteRaw((name + ".raw").c_str());
+
+		if (levels > 0)
+			printf("\nWrote %i tiles to '%s'.\n", pyramid.Write(image, tiles.c_str(), 0, 0, 0, levels), tiles.c_str());
+	}
+	else
+	{
+		//Keep the table's aspect ratio.
+		Raster image(width, std::max(1, (int)(width * ySize / xSize)), -xSize, xSize, -ySize, ySize);
+		InnerPathImage(*table, initial, velocity, n, image);
+		image.WritePGM((name + ".pgm").c_str(), 0.999);
+		image.WriteRaw((name + ".raw").c_str());
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	if (fractal == 2)
+		printf("Took %f s.\n", seconds);
+	else
+		printf("\nWrote '%s.pgm' and '%s.raw' in %f s.\n", name.c_str(), name.c_str(), seconds);
+
+	delete table;
+
+	return;
+}
+
+void LyapunovAnalysis(int choice, int n)
+{
+	int type;
+	double params[3];
+
+	ITable * table = GetTable(choice, type, params);
+
+	Vector initial, velocity;
+	ChooseArgs(initial, velocity, type, params);
+
+	int interval;
+	printf("\n# Re-orthonormalisation: #\nPlease enter bounces between re-orthonormalisations (rec ~ 10): ");
+	std::cin >> interval;
+	if (interval < 1)
+		interval = 1;
+
+	LyapunovSpectrum spectrum(table, initial, velocity);
+
+	std::string name = std::string("lyap") + TableName(choice) + "out.dat";
+
+	FILE * file;
+	file = fopen(name.c_str(), "w");
+
+	printf("\nWriting to '%s'...\n", name.c_str());
+
+	//Exponents per unit time, plus the largest per bounce.
+	fprintf(file, "%-12s%-24s%-24s%-24s%-24s%-24s%-24s\n", "i", "t", "l1", "l2", "l3", "l4", "l1bounce");
+
+	for (int i = 0; i < n; i += interval)
+	{
+		spectrum.Advance(std::min(interval, n - i));
+
+		fprintf(file, "%-12li%-24.15f%-24.15f%-24.15f%-24.15f%-24.15f%-24.15f\n", spectrum.GetBounces(),
+			spectrum.GetTime(), spectrum.GetExponent(0), spectrum.GetExponent(1), spectrum.GetExponent(2),
+			spectrum.GetExponent(3), spectrum.GetBounceExponent(0));
+	}
+
+	fclose(file);
+
+	printf("Lyapunov exponents (per unit time): %f %f %f %f\n", spectrum.GetExponent(0), spectrum.GetExponent(1),
+		spectrum.GetExponent(2), spectrum.GetExponent(3));
+	printf("Largest exponent per bounce: %f\n", spectrum.GetBounceExponent(0));
+
+	printf("Done!\n");
+
+	delete table;
+
+	return;
+}
+
+void DivergenceAnalysis(int choice, int n)
+{
+	int type;
+	double params[3];
+
+	ITable * table = GetTable(choice, type, params);
+
+	Vector initial, velocity;
+	ChooseArgs(initial, velocity, type, params);
+
+	int neighbours;
+	double size;
+	printf("\n# Neighbours: #\nPlease enter number of neighbouring trajectories (rec ~ 1000): ");
+	std::cin >> neighbours;
+	printf("Please enter size of perturbation (rec ~ 1e-10): ");
+	std::cin >> size;
+
+	if (neighbours < 1)
+		neighbours = 1;
+
+	//Neighbours start a distance size away in phase space, in a random
+	//direction. Speed is kept the same so they stay on the same energy.
+	std::default_random_engine engine;
+	engine.seed(std::time(0));
+	std::normal_distribution<double> gaussian(0, 1);
+
+	double speed = velocity.Mod();
+	Ensemble ensemble(neighbours);
+
+	for (int k = 0; k != neighbours; k++)
+	{
+		Vector dq(gaussian(engine), gaussian(engine));
+		Vector dv(gaussian(engine), gaussian(engine));
+		double length = std::sqrt(dq.Dot(dq) + dv.Dot(dv));
+
+		Vector v = velocity + dv * (size * speed / length);
+		ensemble.Add(initial + dq * (size / length), v * (speed / v.Mod()));
+	}
+
+	//Bounces are run in chunks: the reference first, then every neighbour
+	//in parallel, comparing against the stored reference bounces.
+	const int chunk = 256;
+	std::vector<Vector> reference(chunk), referenceV(chunk);
+	std::vector<double> logDistance(chunk * neighbours);
+
+	std::string name = std::string("div") + TableName(choice) + "out.dat";
+
+	FILE * file;
+	file = fopen(name.c_str(), "w");
+
+	printf("\nRunning %i neighbours on %i threads, writing to '%s'...\n", neighbours, ThreadCount(), name.c_str());
+
+	fprintf(file, "%-12s%-24s%-24s%-24s%-24s%-24s%-24s%-24s\n", "i", "mean", "sd", "q10", "q25", "q50", "q75", "q90");
+
+	Vector position = initial;
+
+	for (int done = 0; done < n; done += chunk)
+	{
+		int steps = std::min(chunk, n - done);
+
+		for (int j = 0; j != steps; j++)
+		{
+			position = table->CollisionPoint(position, velocity);
+			velocity = table->ReflectVector(position, velocity);
+			reference[j] = position;
+			referenceV[j] = velocity;
+		}
+
+		ensemble.Run(*table, steps, [&](int ball, int bounce, const Vector & q, const Vector & v, int thread)
+		{
+			Vector dq = q - reference[bounce];
+			Vector dv = v - referenceV[bounce];
+
+			logDistance[bounce * neighbours + ball] = 0.5 * std::log(dq.Dot(dq) + dv.Dot(dv));
+		});
+
+		//Statistics over the neighbours at each bounce.
+		for (int j = 0; j != steps; j++)
+		{
+			double * column = &logDistance[j * neighbours];
+			double mean = 0, square = 0;
+
+			for (int k = 0; k != neighbours; k++)
+			{
+				mean += column[k] / neighbours;
+				square += column[k] * column[k] / neighbours;
+			}
+
+			std::sort(column, column + neighbours);
+
+			double quantile[5];
+			double fraction[5] = {0.1, 0.25, 0.5, 0.75, 0.9};
+			for (int q = 0; q != 5; q++)
+				quantile[q] = column[(int) (fraction[q] * (neighbours - 1) + 0.5)];
+
+			fprintf(file, "%-12i%-24.15f%-24.15f%-24.15f%-24.15f%-24.15f%-24.15f%-24.15f\n", done + j + 1, mean,
+				std::sqrt(std::max(0.0, square - mean * mean)), quantile[0], quantile[1], quantile[2], quantile[3], quantile[4]);
+		}
+	}
+
+	fclose(file);
+
+	printf("Done!\n");
+
+	delete table;
+
+	return;
+}
+
+void DivergenceHeatmap(int choice, int n)
+{
+	int type;
+	double params[3];
+
+	ITable * table = GetTable(choice, type, params);
+
+	int width, height;
+	double growth;
+	printf("\n# Grid Size: #\nPlease enter number of points across (arc length): ");
+	std::cin >> width;
+	printf("Please enter number of points up (angle): ");
+	std::cin >> height;
+	printf("\n# Threshold: #\nPlease enter growth of perturbation to stop at (rec ~ 1e6): ");
+	std::cin >> growth;
+
+	double length = table->BoundaryLength();
+
+	//Grid points are pixel centres, row 0 at the top (p = 1).
+	Raster image(width, height, 0, length, -1, 1);
+
+	//Tiles of tile x tile points, so each thread works on a patch of
+	//nearby initial conditions.
+	const int tile = 16;
+	int tilesX = (width + tile - 1) / tile;
+	int tilesY = (height + tile - 1) / tile;
+
+	printf("\nRunning %i x %i initial conditions on %i threads...\n", width, height, ThreadCount());
+	Scheduler::Global().ResetStatistics();
+
+	ParallelFor(tilesX * tilesY, [&](int begin, int end, int thread)
+	{
+		for (int t = begin; t != end; t++)
+		{
+			int iEnd = std::min(width, (t % tilesX + 1) * tile);
+			int jEnd = std::min(height, (t / tilesX + 1) * tile);
+
+			for (int j = (t / tilesX) * tile; j < jEnd; j++)
+			{
+				for (int i = (t % tilesX) * tile; i < iEnd; i++)
+				{
+					double s = length * (i + 0.5) / width;
+					double p = 1 - 2 * (j + 0.5) / height;
+
+					//Start leaving the wall at s, nudged off it as the
+					//simulation fails for a ball right against the wall.
+					Vector collision = table->BoundaryPoint(s);
+					Vector norm = table->Normal(collision);
+					Vector velocity = Vector(norm.fY, -norm.fX) * p + norm * std::sqrt(1 - p * p);
+					Vector position = collision + norm * (1e-9 * length);
+
+					//Perturbation across the trajectory, in both position
+					//and velocity.
+					Vector across(-velocity.fY * std::sqrt(0.5), velocity.fX * std::sqrt(0.5));
+					Tangent perturbation(across, across);
+
+					int bounces = 0;
+
+					while (bounces < n && perturbation.Mod() < growth)
+					{
+						collision = table->CollisionPoint(position, velocity);
+						perturbation.Flight((collision - position).Mod());
+						perturbation.Bounce(*table, collision, velocity);
+
+						position = collision;
+						velocity = table->ReflectVector(collision, velocity);
+						bounces++;
+					}
+
+					image.SetPixel(i, j, bounces);
+				}
+			}
+		}
+	});
+
+	std::string name = std::string("heat") + TableName(choice) + "out";
+
+	printf("Writing to '%s.dat', '%s.pgm' and '%s.raw' (%i x %i floats)...\n", name.c_str(), name.c_str(),
+		name.c_str(), width, height);
+
+	FILE * file;
+	file = fopen((name + ".dat").c_str(), "w");
+
+	fprintf(file, "%-24s%-24s%-24s\n", "s", "p", "bounces");
+
+	for (int j = 0; j != height; j++)
+	{
+		for (int i = 0; i != width; i++)
+			fprintf(file, "%-24.15f%-24.15f%-24i\n", length * (i + 0.5) / width, 1 - 2 * (j + 0.5) / height,
+				(int) image.GetPixel(i, j));
+
+		//Blank line between rows, for gnuplot's pm3d.
+		fprintf(file, "\n");
+	}
+
+	fclose(file);
+
+	image.WritePGM((name + ".pgm").c_str());
+	image.WriteRaw((name + ".raw").c_str());
+
+	PrintLoadBalance();
+
+	printf("Done!\n");
+
+	delete table;
+
+	return;
+}
+
+void ParameterSweep(int choice, int n)
+{
+	int type;
+	double params[3];
+
+	ITable * base = GetTable(choice, type, params);
+	delete base;
+
+	//Names of the entries of params for each table type, as RandomArgs.
+	const char * names[6][3] = {{}, {"radius"}, {"radius", "x coefficient", "y coefficient"},
+		{"x size", "y size"}, {"x size", "y size"}, {"x size", "y size", "radius"}};
+	int count[6] = {0, 1, 3, 2, 2, 3};
+
+	int sweep = 0;
+	printf("\n# Parameter to Sweep: #\n");
+	for (int k = 0; k != count[type]; k++)
+		printf("(%i) %s\n", k, names[type][k]);
+	printf("Please enter a choice: ");
+	while (!(std::cin >> sweep) || sweep < 0 || sweep >= count[type])
+	{
+		printf("Enter a valid choice: ");
+		std::cin.clear();
+		std::cin.ignore();
+	}
+
+	double from, to;
+	int steps, runs;
+	printf("\n# Range: #\nPlease enter first value: ");
+	std::cin >> from;
+	printf("Please enter last value: ");
+	std::cin >> to;
+	printf("Please enter number of values: ");
+	std::cin >> steps;
+	printf("\n# Runs: #\nPlease enter random initial conditions per value: ");
+	std::cin >> runs;
+
+	if (steps < 1)
+		steps = 1;
+	if (runs < 1)
+		runs = 1;
+
+	//One table per parameter value, shared by its runs.
+	std::vector<double> values(steps);
+	std::vector<ITable *> tables(steps);
+	std::vector<std::vector<double> > geometry(steps, std::vector<double>(params, params + 3));
+
+	for (int k = 0; k != steps; k++)
+	{
+		values[k] = steps > 1 ? from + (to - from) * k / (steps - 1) : from;
+		geometry[k][sweep] = values[k];
+		tables[k] = CreateTable(type, &geometry[k][0]);
+	}
+
+	//Initial conditions made up front, so results don't depend on which
+	//thread runs which item.
+	int items = steps * runs;
+	std::vector<Vector> initial(items), velocity(items);
+
+	std::default_random_engine engine;
+	engine.seed(std::time(0));
+
+	for (int item = 0; item != items; item++)
+		RandomArgs(initial[item], velocity[item], type, &geometry[item / runs][0], engine);
+
+	//Bounces between the points given to the box counter, and the number
+	//of points each run gives it.
+	const int every = 10;
+	int points = (n + every - 1) / every;
+
+	//Box counting levels: leave a few points per box on the finest grid.
+	int levels = 1;
+	while (levels < 10 && std::pow(4.0, levels + 1) * 8 <= points)
+		levels++;
+
+	//What each run gives.
+	struct Result
+	{
+		double lyapunov;
+		double freePath;
+		double dimension;
+	};
+
+	printf("\nRunning %i items on %i threads...\n", items, ThreadCount());
+	Scheduler::Global().ResetStatistics();
+
+	//Runs near different parameter values can take very different times,
+	//which the scheduler evens out by stealing. The results still come
+	//back in item order.
+	std::vector<Result> results = Scheduler::Global().Map<Result>(items, [&](int item)
+	{
+		ITable * table = tables[item / runs];
+		double length = table->BoundaryLength();
+		double s, p;
+
+		LyapunovSpectrum spectrum(table, initial[item], velocity[item]);
+		BoxCounter boxes(levels, 0, length, -1, 1);
+
+		for (int done = 0; done < n; done += every)
+		{
+			spectrum.Advance(std::min(every, n - done));
+
+			BirkhoffCoordinates(*table, spectrum.GetPosition(), spectrum.GetVelocity(), s, p);
+			boxes.Add(s, p);
+		}
+
+		Result result;
+		result.lyapunov = spectrum.GetExponent(0);
+		result.freePath = spectrum.GetTime() * spectrum.GetVelocity().Mod() / spectrum.GetBounces();
+		result.dimension = boxes.Dimension(1, levels);
+		return result;
+	});
+
+	std::string name = std::string("sweep") + TableName(choice) + "out.dat";
+
+	FILE * file;
+	file = fopen(name.c_str(), "w");
+
+	printf("Writing to '%s'...\n", name.c_str());
+
+	fprintf(file, "%-24s%-24s%-24s%-24s%-24s\n", "param", "lyap", "lyaperr", "freepath", "boxdim");
+
+	for (int k = 0; k != steps; k++)
+	{
+		double mean = 0, square = 0, path = 0, dim = 0;
+
+		for (int item = k * runs; item != (k + 1) * runs; item++)
+		{
+			mean += results[item].lyapunov / runs;
+			square += results[item].lyapunov * results[item].lyapunov / runs;
+			path += results[item].freePath / runs;
+			dim += results[item].dimension / runs;
+		}
+
+		//Standard error of the mean exponent.
+		double error = std::sqrt(std::max(0.0, square - mean * mean) / runs);
+
+		fprintf(file, "%-24.15f%-24.15f%-24.15f%-24.15f%-24.15f\n", values[k], mean, error, path, dim);
+
+		delete tables[k];
+	}
+
+	fclose(file);
+
+	PrintLoadBalance();
+
+	printf("Done!\n");
+
+	return;
+}
+
+void PipelineAnalysis(int choice, int n)
+{
+	int type;
+	double params[3];
+
+	ITable * table = GetTable(choice, type, params);
+
+	Vector initial, velocity;
+	ChooseArgs(initial, velocity, type, params);
+
+	//Observers are owned here, the pipeline only borrows them.
+	std::vector<IObserver *> observers;
+	std::string tag = TableName(choice);
+	OpenTable * open = 0;
+
+	printf("\n# Observers: #\n");
+
+	if (GetYesNo("Raw output as for regular plots (1 yes, 0 no): "))
+		observers.push_back(new RawObserver(*table, (std::string("pipe") + tag + "out.dat").c_str()));
+
+	if (GetYesNo("Free path histogram (1 yes, 0 no): "))
+	{
+		double binWidth;
+		int bins;
+		printf("Please enter bin width: ");
+		std::cin >> binWidth;
+		printf("Please enter number of bins: ");
+		std::cin >> bins;
+		observers.push_back(new HistogramObserver(binWidth, bins, (std::string("path") + tag + "out.dat").c_str()));
+	}
+
+	if (GetYesNo("Lyapunov spectrum (1 yes, 0 no): "))
+	{
+		int interval;
+		printf("Please enter bounces between re-orthonormalisations (rec ~ 10): ");
+		std::cin >> interval;
+		observers.push_back(new LyapunovObserver(*table, initial, velocity, interval));
+	}
+
+	if (GetYesNo("Box dimension of bounces (1 yes, 0 no): "))
+	{
+		int levels;
+		printf("Please enter box counting levels (rec ~ 10): ");
+		std::cin >> levels;
+		observers.push_back(new BoxCountObserver(*table, levels));
+	}
+
+	if (GetYesNo("Poincare section image (1 yes, 0 no): "))
+	{
+		int width, height;
+		printf("Please enter image width: ");
+		std::cin >> width;
+		printf("Please enter image height: ");
+		std::cin >> height;
+		observers.push_back(new PoincareObserver(*table, width, height, (std::string("pipe") + tag + "out.pgm").c_str()));
+	}
+
+	if (GetYesNo("Escape through holes (1 yes, 0 no): "))
+	{
+		//Holes are only looked at, the ball still bounces off them.
+		open = new OpenTable(table);
+
+		int holes;
+		printf("The table edge is measured by arc length from 0 to %f.\n", table->BoundaryLength());
+		printf("Please enter number of holes: ");
+		std::cin >> holes;
+
+		for (int i = 0; i != holes; i++)
+		{
+			double start, end;
+			printf("Hole %i start: ", i + 1);
+			std::cin >> start;
+			printf("Hole %i end: ", i + 1);
+			std::cin >> end;
+			open->AddHole(start, end);
+		}
+
+		observers.push_back(new EscapeObserver(*open));
+	}
+
+	if (GetYesNo("Decay of correlations (1 yes, 0 no): "))
+	{
+		int maxLag;
+		printf("Please enter largest lag in bounces: ");
+		std::cin >> maxLag;
+		observers.push_back(new CorrelationObserver(*table, maxLag, (std::string("cor") + tag + "out.dat").c_str()));
+	}
+
+	if (GetYesNo("Symbolic itinerary and entropies (1 yes, 0 no): "))
+	{
+		int maxLength;
+		printf("Please enter longest words to count (rec ~ 12): ");
+		std::cin >> maxLength;
+		observers.push_back(new SymbolObserver(*table, maxLength, (std::string("sym") + tag + "out.bin").c_str(),
+			(std::string("ent") + tag + "out.dat").c_str()));
+	}
+
+	Pipeline pipeline;
+	for (unsigned int o = 0; o != observers.size(); o++)
+		pipeline.Attach(observers[o]);
+
+	HealthMonitor monitor(*table);
+	Trajectory trajectory(*table, initial, velocity);
+	trajectory.SetMonitor(&monitor);
+
+	printf("\nRunning %i bounces through %i observers...\n", n, (int) observers.size());
+
+	pipeline.Run(trajectory, n);
+	monitor.Write(stdout);
+	pipeline.Finish(stdout);
+
+	printf("\n");
+	pipeline.WriteCosts(stdout);
+
+	printf("Done!\n");
+
+	for (unsigned int o = 0; o != observers.size(); o++)
+		delete observers[o];
+
+	delete open;
+	delete table;
+
+	return;
+}
+
+void PredictabilityHorizon(int choice, int n)
+{
+	if (n < 1)
+	{
+		printf("Need at least one ball.\n");
+		return;
+	}
+
+	int type;
+	double params[3];
+
+	ITable * table = GetTable(choice, type, params);
+
+	int maxBounces;
+	double tolerance;
+	printf("\n# Run Length: #\nPlease enter maximum bounces per ball: ");
+	std::cin >> maxBounces;
+	printf("Please enter largest trusted error (rec ~ 1e-6): ");
+	std::cin >> tolerance;
+
+	//Initial conditions generated up front, as for the Poincare section.
+	std::default_random_engine engine;
+	engine.seed(std::time(0));
+
+	std::vector<Vector> initial(n), velocity(n);
+	for (int i = 0; i != n; i++)
+		RandomArgs(initial[i], velocity[i], type, params, engine);
+
+	//Horizon of each ball, and whether its shadow was lost, written by
+	//index so they don't depend on which thread ran which ball.
+	std::vector<long> horizon(n);
+	std::vector<char> lost(n);
+
+	printf("\nRunning %i balls on %i threads...\n", n, ThreadCount());
+	Scheduler::Global().ResetStatistics();
+
+	Scheduler::Global().Run(n, [&](int begin, int end, int thread)
+	{
+		ShadowBatch shadows(*table, type, params);
+		shadows.Horizons(&initial[begin], &velocity[begin], end - begin, tolerance, maxBounces, &horizon[begin], &lost[begin]);
+	});
+
+	//A lost shadow says nothing about how far the double run can be
+	//trusted, so those balls are left out.
+	std::vector<long> sorted;
+	for (int i = 0; i != n; i++)
+		if (!lost[i])
+			sorted.push_back(horizon[i]);
+	std::sort(sorted.begin(), sorted.end());
+
+	int kept = sorted.size();
+	if (kept != n)
+		printf("%i balls lost the table and are left out.\n", n - kept);
+	if (kept == 0)
+	{
+		printf("No balls left.\n");
+		delete table;
+		return;
+	}
+
+	double mean = 0;
+	long never = 0;
+	for (int i = 0; i != kept; i++)
+	{
+		mean += sorted[i];
+		if (sorted[i] >= maxBounces)
+			never++;
+	}
+	mean /= kept;
+
+	printf("Horizon: mean %.1f, min %li, 10%% %li, median %li, 90%% %li bounces\n", mean, sorted[0],
+		sorted[kept / 10], sorted[kept / 2], sorted[(9 * kept) / 10]);
+	if (never > 0)
+		printf("%li balls were still trustworthy after %i bounces.\n", never, maxBounces);
+	printf("Nine in ten runs of this table are trustworthy for %li bounces.\n", sorted[kept / 10]);
+
+	std::string name = std::string("hor") + TableName(choice) + "out.dat";
+
+	FILE * file;
+	file = fopen(name.c_str(), "w");
+
+	printf("\nWriting to '%s'...\n", name.c_str());
+
+	//Fraction of balls trustworthy after each bounce.
+	fprintf(file, "%-12s%-24s\n", "n", "trusted");
+
+	int k = 0;
+	for (int b = 0; b <= maxBounces; b++)
+	{
+		while (k < kept && sorted[k] < b)
+			k++;
+		fprintf(file, "%-12i%-24.15f\n", b, (double)(kept - k) / kept);
+	}
+
+	fclose(file);
+
+	PrintLoadBalance();
+
+	printf("Done!\n");
+
+	delete table;
+
+	return;
+}
+
+void PeriodicOrbitSearch(int choice, int n)
+{
+	if (n < 1)
+	{
+		printf("Need at least one guess.\n");
+		return;
+	}
+
+	int type;
+	double params[3];
+
+	ITable * table = GetTable(choice, type, params);
+
+	int period;
+	printf("\n# Period: #\nPlease enter number of bounces in the orbits: ");
+	while (!(std::cin >> period) || period < 1)
+	{
+		printf("Enter a valid period: ");
+		std::cin.clear();
+		std::cin.ignore();
+	}
+
+	//Guesses spread evenly over the section, away from grazing bounces.
+	std::default_random_engine engine;
+	engine.seed(std::time(0));
+	std::uniform_real_distribution<double> sDist(0, table->BoundaryLength());
+	std::uniform_real_distribution<double> pDist(-0.99, 0.99);
+
+	std::vector<double> s(n), p(n);
+	for (int i = 0; i != n; i++)
+	{
+		s[i] = sDist(engine);
+		p[i] = pDist(engine);
+	}
+
+	printf("\nRefining %i guesses on %i threads...\n", n, ThreadCount());
+	Scheduler::Global().ResetStatistics();
+
+	OrbitSearch search(*table, period);
+	search.Search(s, p, 1e-10);
+
+	int orbits = search.GetOrbitCount(), stable = 0, families = 0;
+	for (int i = 0; i != orbits; i++)
+	{
+		const PeriodicOrbit & orbit = search.GetOrbit(i);
+		if (orbit.IsParabolic())
+			families++;
+		else if (std::abs(orbit.fTrace) < 2)
+			stable++;
+	}
+
+	printf("%li of %i guesses converged, to %i distinct orbits (%i stable, %i unstable, %i parabolic families).\n",
+		search.GetConverged(), n, orbits, stable, orbits - stable - families, families);
+
+	//Shortest orbits first, a long list is left for the file.
+	printf("\n%-8s%-14s%-14s%-14s%-14s%-14s%-8s\n", "period", "s", "p", "length", "trace", "exponent", "family");
+	for (int i = 0; i != orbits && i != 20; i++)
+	{
+		const PeriodicOrbit & orbit = search.GetOrbit(i);
+		printf("%-8i%-14.6f%-14.6f%-14.6f%-14.4g%-14.6f%-8i\n", orbit.fPeriod, orbit.fS[0], orbit.fP[0], orbit.fAction,
+			orbit.fTrace, orbit.fExponent, orbit.fFamily);
+	}
+	if (orbits > 20)
+		printf("... and %i more.\n", orbits - 20);
+
+	std::string name = std::string("orbit") + TableName(choice) + "out.dat";
+
+	FILE * file;
+	file = fopen(name.c_str(), "w");
+
+	printf("\nWriting to '%s'...\n", name.c_str());
+
+	//One line per bounce of each orbit.
+	fprintf(file, "%-8s%-8s%-24s%-24s%-24s%-24s%-24s\n", "orbit", "period", "s", "p", "length", "trace", "exponent");
+
+	for (int i = 0; i != orbits; i++)
+	{
+		const PeriodicOrbit & orbit = search.GetOrbit(i);
+		for (int b = 0; b != orbit.fPeriod; b++)
+		{
+			fprintf(file, "%-8i%-8i%-24.15f%-24.15f%-24.15f%-24.15g%-24.15f\n", i, orbit.fPeriod, orbit.fS[b], orbit.fP[b],
+				orbit.fAction, orbit.fTrace, orbit.fExponent);
+		}
+	}
+
+	fclose(file);
+
+	PrintLoadBalance();
+
+	printf("Done!\n");
+
+	delete table;
+
+	return;
+}
+
+void SymbolicAnalysis(int choice, int n)
+{
+	int type;
+	double params[3];
+
+	ITable * table = GetTable(choice, type, params);
+
+	if (table->ComponentCount() < 2)
+		printf("This table has a single wall, so every itinerary is the same.\n");
+
+	Vector initial, velocity;
+	ChooseArgs(initial, velocity, type, params);
+
+	int maxLength;
+	printf("\n# Words: #\nPlease enter longest words to count (rec ~ 12): ");
+	std::cin >> maxLength;
+
+	std::string tag = TableName(choice);
+	SymbolObserver symbols(*table, maxLength, (std::string("sym") + tag + "out.bin").c_str(),
+		(std::string("ent") + tag + "out.dat").c_str());
+
+	Pipeline pipeline;
+	pipeline.Attach(&symbols);
+
+	HealthMonitor monitor(*table);
+	Trajectory trajectory(*table, initial, velocity);
+	trajectory.SetMonitor(&monitor);
+
+	printf("\nRunning %i bounces...\n", n);
+
+	pipeline.Run(trajectory, n);
+	monitor.Write(stdout);
+	pipeline.Finish(stdout);
+
+	printf("\n");
+	pipeline.WriteCosts(stdout);
+
+	printf("Done!\n");
+
+	delete table;
+
+	return;
+}
+
+void ErgodicAnalysis(int choice, int n)
+{
+	int type;
+	double params[3];
+
+	ITable * table = GetTable(choice, type, params);
+
+	Vector initial, velocity;
+	ChooseArgs(initial, velocity, type, params);
+
+	int bins;
+	double tolerance;
+	printf("\n# Averages: #\nPlease enter number of bins in the distributions: ");
+	std::cin >> bins;
+	printf("Please enter relative tolerance (rec ~ 0.01): ");
+	std::cin >> tolerance;
+
+	ErgodicAverages averages(*table, bins, tolerance);
+
+	HealthMonitor monitor(*table);
+	Trajectory trajectory(*table, initial, velocity);
+	trajectory.SetMonitor(&monitor);
+
+	printf("\nRunning up to %i bounces...\n", n);
+	printf("%-14s%-16s%-16s%-12s\n", "bounces", "free path", "worst error", "worst");
+
+	const char * names[] = {"free path", "arc length", "angle"};
+	long length = averages.GetBatchLength();
+
+	Bounce bounce;
+	for (long i = 0; i <= n && trajectory.Next(bounce); i++)
+	{
+		if (averages.Add(bounce))
+			break;
+
+		//Progress each time the batches double.
+		if (averages.GetBatchLength() != length)
+		{
+			length = averages.GetBatchLength();
+
+			int worst;
+			double error = averages.Worst(worst);
+			if (length >= 32)
+				printf("%-14li%-16f%-16f%-12s\n", averages.GetCount(), averages.GetFreePath(), error,
+					names[worst]);
+		}
+	}
+
+	monitor.Write(stdout);
+	averages.Write(stdout);
+
+	if (averages.IsConverged())
+		printf("Converged to %g after %li bounces.\n", tolerance, averages.GetCount());
+	else
+		printf("Not converged to %g after %li bounces.\n", tolerance, averages.GetCount());
+
+	std::string name = std::string("erg") + TableName(choice) + "out.dat";
+
+	FILE * file;
+	file = fopen(name.c_str(), "w");
+
+	printf("\nWriting to '%s'...\n", name.c_str());
+
+	averages.WriteDistributions(file);
+
+	fclose(file);
+
+	printf("Done!\n");
+
+	delete table;
+
+	return;
+}
+
+void CorrelationAnalysis(int choice, int n)
+{
+	int type;
+	double params[3];
+
+	ITable * table = GetTable(choice, type, params);
+
+	Vector initial, velocity;
+	ChooseArgs(initial, velocity, type, params);
+
+	int maxLag;
+	printf("\n# Lags: #\nPlease enter largest lag in bounces: ");
+	std::cin >> maxLag;
+
+	CorrelationObserver correlation(*table, maxLag, (std::string("cor") + TableName(choice) + "out.dat").c_str());
+
+	Pipeline pipeline;
+	pipeline.Attach(&correlation);
+
+	HealthMonitor monitor(*table);
+	Trajectory trajectory(*table, initial, velocity);
+	trajectory.SetMonitor(&monitor);
+
+	printf("\nRunning %i bounces...\n", n);
+
+	pipeline.Run(trajectory, n);
+	monitor.Write(stdout);
+	pipeline.Finish(stdout);
+
+	printf("\n");
+	pipeline.WriteCosts(stdout);
+
+	printf("Done!\n");
+
+	delete table;
+
+	return;
+}
+
+void MixingAnalysis(int choice, int n)
+{
+	if (n < 1)
+	{
+		printf("Need at least one ball.\n");
+		return;
+	}
+
+	int type;
+	double params[3];
+
+	ITable * table = GetTable(choice, type, params);
+
+	Vector initial, velocity;
+	ChooseArgs(initial, velocity, type, params);
+
+	double spread, dt;
+	int steps, cells, angles;
+	printf("\n# Ensemble: #\nPlease enter spread of starting directions (radians, rec ~ 0.01): ");
+	std::cin >> spread;
+	printf("Please enter time step: ");
+	std::cin >> dt;
+	printf("Please enter number of steps: ");
+	std::cin >> steps;
+	printf("Please enter grid cells across the table (rec ~ 32): ");
+	std::cin >> cells;
+	printf("Please enter grid cells in direction (rec ~ 16): ");
+	std::cin >> angles;
+
+	//Speed 1, so time is the same as path length.
+	std::default_random_engine engine;
+	engine.seed(std::time(0));
+	std::uniform_real_distribution<double> rangeA(-spread / 2, spread / 2);
+	double direction = std::atan2(velocity.fY, velocity.fX);
+
+	Ensemble ensemble(n);
+	for (int i = 0; i != n; i++)
+	{
+		double angle = direction + rangeA(engine);
+		ensemble.Add(initial, Vector(std::cos(angle), std::sin(angle)));
+	}
+
+	double x, y;
+	TableExtent(type, params, x, y);
+
+	int threads = ThreadCount();
+	PhaseEntropy entropy(x, y, cells, angles, threads);
+	std::vector<double> squares(threads);
+
+	std::string name = std::string("step") + TableName(choice) + "out.dat";
+
+	FILE * file;
+	file = fopen(name.c_str(), "w");
+
+	fprintf(file, "%-24s%-24s%-12s%-24s\n", "t", "entropy", "occupied", "msd");
+
+	int occupied;
+	for (int i = 0; i != n; i++)
+		entropy.Add(ensemble.GetPosition(i), ensemble.GetVelocity(i), 0);
+	double first = entropy.Entropy(occupied);
+	fprintf(file, "%-24.15f%-24.15f%-12i%-24.15f\n", 0.0, first, occupied, 0.0);
+
+	printf("\nRunning %i balls for %i steps on %i threads...\n", n, steps, threads);
+	Scheduler::Global().ResetStatistics();
+
+	double last = first;
+	int reached = 0, dropped = 0;
+	std::vector<char> lost;
+
+	for (int k = 1; k <= steps; k++)
+	{
+		std::fill(squares.begin(), squares.end(), 0);
+
+		int stuck = ensemble.Advance(*table, dt, [&](int ball, const Vector & position, const Vector & velocity, int thread)
+		{
+			entropy.Add(position, velocity, thread);
+
+			Vector moved = position - initial;
+			squares[thread] += moved.Dot(moved);
+		}, lost);
+
+		//Stuck balls are dropped rather than left to hang the run.
+		if (stuck > 0)
+		{
+			ensemble.Compact(lost);
+			dropped += stuck;
+		}
+
+		if (ensemble.GetActive() == 0)
+		{
+			printf("Every ball was lost by step %i.\n", k);
+			break;
+		}
+
+		double msd = 0;
+		for (int t = 0; t != threads; t++)
+			msd += squares[t];
+		msd /= ensemble.GetActive();
+
+		last = entropy.Entropy(occupied);
+		reached = std::max(reached, occupied);
+
+		fprintf(file, "%-24.15f%-24.15f%-12i%-24.15f\n", k * dt, last, occupied, msd);
+	}
+
+	fclose(file);
+
+	if (dropped > 0)
+		printf("%i balls were dropped, stuck in a corner or with broken numbers.\n", dropped);
+
+	//Balls spread evenly over the cells reached would give ln(cells).
+	printf("Entropy from %f to %f nats, %i of %i cells reached (ln %f).\n", first, last, reached,
+		entropy.GetCells(), std::log((double) std::max(reached, 1)));
+
+	printf("\nWritten to '%s'.\n", name.c_str());
+
+	PrintLoadBalance();
+
+	printf("Done!\n");
+
+	delete table;
+
+	return;
+}
+
+void CloningAnalysis(int choice, int n)
+{
+	if (n < 2)
+	{
+		printf("Need at least two walkers.\n");
+		return;
+	}
+
+	int type;
+	double params[3];
+
+	ITable * table = GetTable(choice, type, params);
+
+	int interval, resamplings, values;
+	double sMin, sMax, noise;
+	printf("\n# Cloning: #\nPlease enter bounces between resamplings (rec ~ 10): ");
+	std::cin >> interval;
+	printf("Please enter number of resamplings: ");
+	std::cin >> resamplings;
+	printf("Please enter smallest bias s: ");
+	std::cin >> sMin;
+	printf("Please enter largest bias s: ");
+	std::cin >> sMax;
+	printf("Please enter number of values of s: ");
+	std::cin >> values;
+	printf("Please enter noise given to copies (radians, rec ~ 1e-8): ");
+	std::cin >> noise;
+
+	if (values < 1)
+		values = 1;
+
+	std::default_random_engine engine;
+	engine.seed(std::time(0));
+
+	std::string name = std::string("clone") + TableName(choice) + "out.dat";
+
+	FILE * file;
+	file = fopen(name.c_str(), "w");
+
+	fprintf(file, "%-24s%-24s%-24s%-24s\n", "s", "psi", "lyapunov", "copied");
+
+	printf("\nRunning %i walkers on %i threads...\n", n, ThreadCount());
+	printf("\n%-12s%-16s%-16s%-12s\n", "s", "psi(s)", "lyapunov", "copied");
+	Scheduler::Global().ResetStatistics();
+
+	for (int k = 0; k != values; k++)
+	{
+		double s = values > 1 ? sMin + (sMax - sMin) * k / (values - 1) : sMin;
+
+		//A fresh population for each s, so the runs are independent.
+		Cloning cloning(*table, interval, noise);
+		for (int i = 0; i != n; i++)
+		{
+			Vector initial, velocity;
+			RandomArgs(initial, velocity, type, params, engine);
+			cloning.Add(initial, velocity);
+		}
+
+		cloning.Run(s, resamplings);
+
+		printf("%-12.4f%-16.8f%-16.8f%-12.4f\n", s, cloning.GetSCGF(), cloning.GetLyapunov(), cloning.GetClones());
+		fprintf(file, "%-24.15f%-24.15f%-24.15f%-24.15f\n", s, cloning.GetSCGF(), cloning.GetLyapunov(), cloning.GetClones());
+	}
+
+	fclose(file);
+
+	printf("\nWritten to '%s'.\n", name.c_str());
+
+	PrintLoadBalance();
+
+	printf("Done!\n");
+
+	delete table;
+
+	return;
+}
+
+void InnerPathImage(ITable & table, Vector & position, Vector & velocity, int n, Raster & image)
+{
+	//Bounces worked out between each parallel drawing step.
+	const int block = 1 << 16;
+
+	std::vector<Vector> points(block + 1);
+	SharedRaster shared(image, ThreadCount());
+
+	points[0] = position;
+
+	for (int done = 0; done < n; )
+	{
+		int m = std::min(block, n - done);
+
+		//The trajectory itself can't be split up.
+		for (int k = 1; k <= m; k++)
+		{
+			position = table.CollisionPoint(position, velocity);
+			velocity = table.ReflectVector(position, velocity);
+			points[k] = position;
+		}
+
+		//But drawing it can.
+		ParallelFor(m, [&](int begin, int end, int thread)
+		{
+			for (int k = begin; k != end; k++)
+				shared.AddLine(points[k].fX, points[k].fY, points[k+1].fX, points[k+1].fY, thread);
+		});
+
+		points[0] = points[m];
+		done += m;
+	}
+
+	shared.Flush();
+}
+
+void InnerFracImage(ITable & table, const Vector & position, const Vector & velocity, int n, Raster & image,
+	double thetaMin, double thetaMax)
+{
+	SharedRaster shared(image, ThreadCount());
+
+	ParallelFor(n, [&](int begin, int end, int thread)
+	{
+		for (int i = begin; i != end; i++)
+		{
+			//Same angles as InnerFrac, worked out directly rather than
+			//by repeated rotation. Velocity has argument -theta.
+			double theta = thetaMin + (thetaMax - thetaMin) * (1.0 * i / n);
+			Vector p = position;
+			Vector v = velocity.Rotate(-theta - M_PI);
+			Vector t;
+			double pLength = 0;
+
+			for (int j = 0; j != 30; j++)
+			{
+				t = table.CollisionPoint(p, v);
+				pLength += (p - t).Mod();
+				p = t;
+				v = table.ReflectVector(p, v);
+
+				//Mirror-room point, (xVec, yVec) in InnerFrac.
+				shared.Add(pLength * std::cos(theta), pLength * std::sin(theta), thread);
+			}
+		}
+	});
+
+	shared.Flush();
+}
+
+void InnerRun(ITable & table, Vector & position, Vector & velocity, int n, FILE * file, CycleDetector * cycles)
+{
+	//Initial angle is that of the velocity.
+	double angle = velocity.Arg();
+
+	//Print headers to file.
+	fprintf(file, "%-10s%-20s%-20s%-20s%-20s%-20s%-20s%-20s%-20s%-20s\n", "i", "x", "y", "mp", "pa", "a", "vx", "vy", "mv", "va");
+
+	//Every bounce is checked, and the run stops early if one goes wrong.
+	HealthMonitor monitor(table);
+	Trajectory trajectory(table, position, velocity);
+	trajectory.SetMonitor(&monitor);
+
+	//Records 0 to n - 1 are printed, record n is where the ball ends up.
+	for (const Bounce & bounce : Take(trajectory, n + 1))
+	{
+		position = bounce.fPosition;
+		velocity = bounce.fVelocity;
+
+		if (bounce.fIndex == n)
+			break;
+
+		//Find angle between table wall and ball trajectory.
+		if (bounce.fIndex > 0)
+			angle = std::fmod(table.AngleIncidence(bounce.fPosition, bounce.fIncoming), 2*M_PI);
+
+		//Print current status.
+		fprintf(file, "%-10li%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f\n", 
+			bounce.fIndex, bounce.fPosition.fX, bounce.fPosition.fY, bounce.fPosition.Mod(), bounce.fPosition.Arg(),
+			angle, bounce.fVelocity.fX, bounce.fVelocity.fY, bounce.fVelocity.Mod(), bounce.fVelocity.Arg());
+
+		//Stop once the orbit has been seen to repeat.
+		if (cycles && bounce.fIndex > 0)
+		{
+			double s, p;
+			BirkhoffCoordinates(table, bounce.fPosition, bounce.fVelocity, s, p);
+
+			if (cycles->Add(bounce.fIndex, s, p))
+			{
+				fprintf(file, "# periodic with period %li from bounce %li\n", cycles->GetPeriod(), cycles->GetStart());
+				printf("Periodic orbit with period %li from bounce %li, stopped after bounce %li.\n",
+					cycles->GetPeriod(), cycles->GetStart(), bounce.fIndex);
+				break;
+			}
+		}
+	}
+
+	monitor.Write(stdout);
+}
+
+void InnerFrac(ITable & table, Vector & position, Vector & velocity, int n, FILE * file)
+{
+	//Initialise varibales and temporary variables.
+	double tLength, pLength = 0, xLength = 0, yLength = 0, theta;
+	//pLength, xLength and yLength are the important data to output,
+	//tLength and theta are temporary useful variables.
+
+	//Store initial conditions, as they must be returned to after each run.
+	Vector initial = position;
+	Vector vInitial = velocity;
 
 	//Temporary position vector.
 	Vector tPosition;
 	
+	//Temporary velocity vector, checked before it is used.
+	Vector tVelocity;
+
+	//Every bounce is checked, as in InnerRun, and the whole plot stops
+	//early if one goes wrong.
+	HealthMonitor monitor(table);
+	bool healthy = true;
+
 	//Write header to file.
 	fprintf(file, "%-24s%-24s%-24s%-24s%-24s%-24s%-24s\n", "i", "pLength", "angle", "xLength", "yLength", "xVec", "yVec");
 	
-	for (int i = 0; i != n; i++)
+	for (int i = 0; i != n && healthy; i++)
 	{
 		//One run of the simulation:
 		//Initial angle for velocity.
 		theta = -M_PI + (2 * M_PI) * (1.0 * i / n);
+		monitor.Start(velocity);
 		for (int j = 0; j != 30; j++)
 		{
 			//Compute next poisition.
 			tPosition = table.CollisionPoint(position, velocity);
+			tVelocity = table.ReflectVector(tPosition, velocity);
+
+			if (!monitor.Inspect(position, tPosition, velocity, tVelocity))
+			{
+				healthy = false;
+				break;
+			}
+
 			//Path length from current to next position.
 			tLength = (position - tPosition).Mod();
 			//Add to total path.
@@ -1030,7 +3263,7 @@ void InnerFrac(ITable & table, Vector & position, Vector & velocity, int n, FILE
 			
 			//Update position and velocity.
 			position = tPosition;
-			velocity = table.ReflectVector(position, velocity);
+			velocity = tVelocity;
 			
 			//Now using tPosition for mirror-room plot.
 			//tPosition is total path length with same argument as 
@@ -1054,12 +3287,217 @@ void InnerFrac(ITable & table, Vector & position, Vector & velocity, int n, FILE
 		xLength = 0;
 		yLength = 0;
 	}
+
+	monitor.Write(stdout);
+}
+
+void InnerFracAdaptive(ITable & table, const Vector & position, const Vector & velocity, int n, int coarse, FILE * file)
+{
+	//One run of the simulation is kept as its initial angle, the total path
+	//length and the wall it finished on, used to decide where to refine,
+	//and the number of bounces which passed the health checks.
+	struct Sample
+	{
+		double theta;
+		double length;
+		int wall;
+		int bounces;
+	};
+
+	//Interval of angles between samples a and b, ordered by score.
+	struct Interval
+	{
+		double score;
+		int a;
+		int b;
+
+		bool operator<(const Interval & other) const { return score < other.score; }
+	};
+
+	//Need at least two angles to have an interval to split.
+	if (coarse < 2)
+		coarse = 2;
+	if (coarse > n)
+		coarse = n;
+
+	std::vector<Sample> samples(coarse);
+	//pLength, xLength and yLength after each bounce, for each run in a round.
+	std::vector<double> rows;
+
+	//Every bounce is checked, as in InnerFrac, with a monitor per thread.
+	//Refinement stops after the round in which a run goes wrong.
+	std::vector<HealthMonitor> monitors(ThreadCount(), HealthMonitor(table));
+	bool healthy = true;
+
+	//Simulate all samples from first onwards in parallel, then write them.
+	auto round = [&](int first)
+	{
+		int count = samples.size() - first;
+		rows.resize(count * 90);
+
+		ParallelFor(count, [&](int begin, int end, int thread)
+		{
+			for (int i = begin; i != end; i++)
+			{
+				Sample & sample = samples[first + i];
+				double * row = &rows[i * 90];
+				//Same initial velocity as InnerFrac, argument -theta.
+				Vector p = position;
+				Vector v = velocity.Rotate(-sample.theta - M_PI);
+				Vector t, u;
+				double pLength = 0, xLength = 0, yLength = 0;
+
+				monitors[thread].Start(v);
+				sample.bounces = 30;
+
+				for (int j = 0; j != 30; j++)
+				{
+					t = table.CollisionPoint(p, v);
+					u = table.ReflectVector(t, v);
+
+					if (!monitors[thread].Inspect(p, t, v, u))
+					{
+						sample.bounces = j;
+						break;
+					}
+
+					pLength += (p - t).Mod();
+					xLength += std::abs(p.fX - t.fX);
+					yLength += std::abs(p.fY - t.fY);
+					p = t;
+					v = u;
+
+					row[j * 3] = pLength;
+					row[j * 3 + 1] = xLength;
+					row[j * 3 + 2] = yLength;
+				}
+
+				sample.length = pLength;
+				sample.wall = table.Component(p);
+			}
+		});
+
+		for (int i = 0; i != count; i++)
+		{
+			double theta = samples[first + i].theta;
+			double * row = &rows[i * 90];
+
+			if (samples[first + i].bounces < 30)
+				healthy = false;
+
+			for (int j = 0; j != samples[first + i].bounces; j++)
+				fprintf(file, "%-24i%-24.15f%-24.15f%-24.15f%-24.15f%-24.15f%-24.15f\n", j, row[j * 3], theta,
+					row[j * 3 + 1], row[j * 3 + 2], row[j * 3] * std::cos(theta), row[j * 3] * std::sin(theta));
+		}
+	};
+
+	//Write header to file.
+	fprintf(file, "%-24s%-24s%-24s%-24s%-24s%-24s%-24s\n", "i", "pLength", "angle", "xLength", "yLength", "xVec", "yVec");
+
+	//No runs, as for InnerFrac, and no first run to close the grid with.
+	if (n < 1)
+		return;
+
+	//Coarse grid, as InnerFrac.
+	for (int i = 0; i != coarse; i++)
+		samples[i].theta = -M_PI + (2 * M_PI) * (1.0 * i / coarse);
+	round(0);
+
+	//Angle pi is the same run as -pi, added to close the last interval.
+	Sample last = samples[0];
+	last.theta = M_PI;
+	samples.push_back(last);
+
+	//Path lengths are compared relative to the mean.
+	double scale = 0;
+	for (int i = 0; i != coarse; i++)
+		scale += samples[i].length / coarse;
+	if (scale <= 0)
+		scale = 1;
+
+	//An interval scores highly if it is wide and the path length or final
+	//wall changes across it. Smooth regions score roughly as width squared,
+	//jumps only as width, so refinement concentrates on the jumps.
+	auto score = [&](int a, int b)
+	{
+		double change = std::abs(samples[b].length - samples[a].length) / scale;
+		if (samples[a].wall != samples[b].wall)
+			change += 1;
+
+		return (samples[b].theta - samples[a].theta) * change;
+	};
+
+	std::priority_queue<Interval> queue;
+	for (int i = 0; i != coarse; i++)
+		queue.push({score(i, i + 1), i, i + 1});
+
+	//Split a batch of the highest scoring intervals each round.
+	int batch = 64 * ThreadCount();
+	int total = coarse;
+	std::vector<Interval> split;
+
+	while (healthy && total < n && !queue.empty())
+	{
+		split.clear();
+		while ((int) split.size() < batch && total + (int) split.size() < n && !queue.empty())
+		{
+			Interval top = queue.top();
+			queue.pop();
+
+			//Intervals this narrow can't be resolved any further.
+			if (samples[top.b].theta - samples[top.a].theta > 1e-12)
+				split.push_back(top);
+		}
+
+		int first = samples.size();
+		for (unsigned int k = 0; k != split.size(); k++)
+		{
+			Sample middle;
+			middle.theta = 0.5 * (samples[split[k].a].theta + samples[split[k].b].theta);
+			samples.push_back(middle);
+		}
+
+		round(first);
+
+		for (unsigned int k = 0; k != split.size(); k++)
+		{
+			int m = first + k;
+			queue.push({score(split[k].a, m), split[k].a, m});
+			queue.push({score(m, split[k].b), m, split[k].b});
+		}
+
+		total += split.size();
+	}
+
+	for (unsigned int t = 1; t < monitors.size(); t++)
+		monitors[0].Merge(monitors[t]);
+	monitors[0].Write(stdout);
+}
+
+bool GetAdaptive(int & coarse)
+{
+	bool adaptive = GetYesNo("\n# Angle Sampling: #\nEnter 1 for adaptive angles, and 0 for evenly spaced: ");
+
+	coarse = 0;
+	if (adaptive)
+	{
+		printf("Please enter number of evenly spaced angles to start from (rec ~ 1000): ");
+		std::cin >> coarse;
+	}
+
+	return adaptive;
 }
 
 void InnerChaos(ITable & table, Vector & position1, Vector & position2, Vector & velocity1, Vector & velocity2, int n, FILE * file)
 {
 	fprintf(file, "%-24s%-24s%-24s%-24s%-24s%-24s%-24s%-24s\n", "i", "1x", "1y", "1pa", "2x", "2y", "2pa", "dpa");
 
+	//Both balls are checked every bounce, as in InnerRun, and the run stops
+	//early if either goes wrong.
+	HealthMonitor monitor1(table), monitor2(table);
+	monitor1.Start(velocity1);
+	monitor2.Start(velocity2);
+
 	for (int i = 0; i != n; i++)
 	{
 		//Print current status.
@@ -1067,12 +3505,156 @@ void InnerChaos(ITable & table, Vector & position1, Vector & position2, Vector &
 			i, position1.fX, position1.fY, position1.Arg(),
 			position2.fX, position2.fY, position2.Arg(), std::abs(position1.Arg() - position2.Arg()));
 		//Find next position.
-		position1 = table.CollisionPoint(position1, velocity1);
-		position2 = table.CollisionPoint(position2, velocity2);
+		Vector collision1 = table.CollisionPoint(position1, velocity1);
+		Vector collision2 = table.CollisionPoint(position2, velocity2);
 		//Find velocity after collision.
-		velocity1 = table.ReflectVector(position1, velocity1);
-		velocity2 = table.ReflectVector(position2, velocity2);
+		Vector reflected1 = table.ReflectVector(collision1, velocity1);
+		Vector reflected2 = table.ReflectVector(collision2, velocity2);
+
+		//Both are checked, so both failures are counted.
+		bool healthy1 = monitor1.Inspect(position1, collision1, velocity1, reflected1);
+		bool healthy2 = monitor2.Inspect(position2, collision2, velocity2, reflected2);
+		if (!healthy1 || !healthy2)
+			break;
+
+		position1 = collision1;
+		position2 = collision2;
+		velocity1 = reflected1;
+		velocity2 = reflected2;
+	}
+
+	monitor1.Merge(monitor2);
+	monitor1.Write(stdout);
+}
+
+void InnerRunPrecise(ITable & table, int type, double params[], Vector & position, Vector & velocity, int n, FILE * file)
+{
+	TableKernel<DoubleDouble> kernel(type, params);
+	TVector<DoubleDouble> p(position), v(velocity);
+
+	//Initial angle is that of the velocity.
+	double angle = velocity.Arg();
+
+	fprintf(file, "%-10s%-20s%-20s%-20s%-20s%-20s%-20s%-20s%-20s%-20s\n", "i", "x", "y", "mp", "pa", "a", "vx", "vy", "mv", "va");
+
+	for (int i = 0; i != n; i++)
+	{
+		position = p.ToVector();
+		velocity = v.ToVector();
+
+		fprintf(file, "%-10i%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f%-20.15f\n",
+			i, position.fX, position.fY, position.Mod(), position.Arg(),
+			angle, velocity.fX, velocity.fY, velocity.Mod(), velocity.Arg());
+
+		if (kernel.Step(p, v) < 0)
+		{
+			printf("Ball lost the table after %i bounces.\n", i);
+			return;
+		}
+
+		//Angle between wall and incoming trajectory, as InnerRun.
+		angle = std::fmod(table.AngleIncidence(p.ToVector(), velocity), 2*M_PI);
+	}
+
+	position = p.ToVector();
+	velocity = v.ToVector();
+}
+
+void InnerChaosPrecise(ITable & table, int type, double params[], Vector & position1, Vector & position2, Vector & velocity1, Vector & velocity2, int n, FILE * file)
+{
+	//Both balls run together, one in each lane.
+	typedef DoubleDoubleLanes<2> Lanes;
+
+	BatchKernel<2> kernel(type, params);
+	TVector<Lanes> p(Lanes(0), Lanes(0)), v(Lanes(0), Lanes(0));
+	kernel.SetLane(p, 0, TVector<DoubleDouble>(position1));
+	kernel.SetLane(v, 0, TVector<DoubleDouble>(velocity1));
+	kernel.SetLane(p, 1, TVector<DoubleDouble>(position2));
+	kernel.SetLane(v, 1, TVector<DoubleDouble>(velocity2));
+
+	fprintf(file, "%-24s%-24s%-24s%-24s%-24s%-24s%-24s%-24s\n", "i", "1x", "1y", "1pa", "2x", "2y", "2pa", "dpa");
+
+	for (int i = 0; i != n; i++)
+	{
+		position1 = kernel.GetLane(p, 0).ToVector();
+		position2 = kernel.GetLane(p, 1).ToVector();
+		velocity1 = kernel.GetLane(v, 0).ToVector();
+		velocity2 = kernel.GetLane(v, 1).ToVector();
+
+		fprintf(file, "%-24i%-24.15f%-24.15f%-24.15f%-24.15f%-24.15f%-24.15f%-24.15f\n",
+			i, position1.fX, position1.fY, position1.Arg(),
+			position2.fX, position2.fY, position2.Arg(), std::abs(position1.Arg() - position2.Arg()));
+
+		//Both balls are left where they were last written if either is lost.
+		Lanes time = kernel.Step(p, v);
+		if (time.Get(0) < DoubleDouble(0) || time.Get(1) < DoubleDouble(0))
+		{
+			printf("Ball lost the table after %i bounces.\n", i);
+			return;
+		}
+	}
+
+	position1 = kernel.GetLane(p, 0).ToVector();
+	position2 = kernel.GetLane(p, 1).ToVector();
+	velocity1 = kernel.GetLane(v, 0).ToVector();
+	velocity2 = kernel.GetLane(v, 1).ToVector();
+}
+
+bool GetCycleDetection(ITable & table, CycleDetector & cycles)
+{
+	bool detect = GetYesNo("\n# Periodic Orbits: #\nEnter 1 to stop when the orbit repeats, and 0 to run every bounce: ");
+
+	if (detect)
+	{
+		//Cells are the same fraction of the edge length and of the range of p.
+		double cell;
+		printf("Please enter how close bounces must come back, as a fraction (rec ~ 1e-9): ");
+		std::cin >> cell;
+		cycles = CycleDetector(cell * table.BoundaryLength(), 2 * cell);
+	}
+
+	return detect;
+}
+
+int GetPrecision(double & tolerance)
+{
+	int precision;
+
+	printf("\n# Precision: #\n(0) Double\n(1) Double-double (slower, accurate for longer)\n");
+	printf("(2) Double, stopped where it stops being trustworthy\nPlease enter a choice: ");
+
+	while (!(std::cin >> precision) || precision < 0 || precision > 2)
+	{
+		std::cin.clear();
+		std::cin.ignore();
+		printf("Please enter a valid choice: ");
+	}
+
+	tolerance = 0;
+	if (precision == 2)
+	{
+		printf("Please enter largest trusted error (rec ~ 1e-6): ");
+		std::cin >> tolerance;
 	}
+
+	return precision;
+}
+
+int TrustedBounces(ITable & table, int type, double params[], const Vector & position, const Vector & velocity, int n, double tolerance)
+{
+	Shadow shadow(table, type, params, position, velocity);
+
+	//Records 0 to horizon are trusted.
+	int trusted = std::min((long) n, shadow.Horizon(tolerance, n) + 1);
+
+	if (shadow.IsLost())
+		printf("\nBall lost the table after %i bounces, stopping there.\n", trusted - 1);
+	else if (trusted < n)
+		printf("\nTrustworthy for %i bounces, stopping there.\n", trusted - 1);
+	else
+		printf("\nTrustworthy for all %i bounces.\n", n);
+
+	return trusted;
 }
 
 void GetArgs(Vector & initial, Vector & velocity)
@@ -1097,12 +3679,142 @@ void GetArgs(Vector & initial, Vector & velocity)
 	return; 
 }
 
+void ChooseArgs(Vector & initial, Vector & velocity, int type, double params[])
+{
+	bool random = GetYesNo("\n# Initial Conditions: #\nEnter 1 for random initial conditions, and 0 for user-input: ");
+
+	if (random)
+		RandomArgs(initial, velocity, type, params);
+	else
+		GetArgs(initial, velocity);
+}
+
+ITable * GetTable(int choice, int & type, double params[])
+{
+	//Same prompts as the Run functions. params are ordered as RandomArgs
+	//expects them.
+	switch (choice)
+	{
+		case 1:
+			type = 4;
+			printf("\n# Table Dimensions: #\nPlease enter y size: ");
+			std::cin >> params[1];
+			printf("Please enter x size: ");
+			std::cin >> params[0];
+			break;
+		case 2:
+			type = 2;
+			printf("\n# Table Dimensions: #\nPlease enter y coefficient: ");
+			std::cin >> params[2];
+			printf("Please enter x coefficient: ");
+			std::cin >> params[1];
+			printf("Please enter radius: ");
+			std::cin >> params[0];
+			break;
+		case 3:
+			type = 1;
+			printf("\n# Table Dimensions: #\nPlease enter radius: ");
+			std::cin >> params[0];
+			break;
+		case 4:
+			type = 3;
+			printf("\n# Table Dimensions: #\nPlease enter y size: ");
+			std::cin >> params[1];
+			printf("Please enter x size: ");
+			std::cin >> params[0];
+			break;
+		case 5:
+			type = 5;
+			printf("\n# Table Dimensions: #\nPlease enter y size: ");
+			std::cin >> params[1];
+			printf("Please enter x size: ");
+			std::cin >> params[0];
+			printf("Please enter radius of inner circle: ");
+			std::cin >> params[2];
+			break;
+	}
+
+	return CreateTable(type, params);
+}
+
+bool GetYesNo(const char * question)
+{
+	bool answer;
+
+	printf("%s", question);
+
+	while (!(std::cin >> answer))
+	{
+		std::cin.clear();
+		std::cin.ignore();
+		printf("Please enter a valid choice: ");
+	}
+
+	return answer;
+}
+
+void PrintLoadBalance()
+{
+	printf("\n# Load Balance: #\n");
+	Scheduler::Global().WriteStatistics(stdout);
+	printf("\n");
+}
+
+const char * TableName(int choice)
+{
+	//Matches the names of the existing output files.
+	switch (choice)
+	{
+		case 1:
+			return "stad";
+		case 2:
+			return "elip";
+		case 3:
+			return "circ";
+		case 4:
+			return "rect";
+		case 5:
+			return "lore";
+	}
+
+	return "";
+}
+
+void TableExtent(int type, double params[], double & x, double & y)
+{
+	switch (type)
+	{
+		case 1:
+			x = y = params[0];
+			break;
+		case 2:
+			x = params[0] * params[1];
+			y = params[0] * params[2];
+			break;
+		case 3:
+		case 5:
+			x = params[0];
+			y = params[1];
+			break;
+		case 4:
+			//Semi-circles stick out past x.
+			x = params[0] + params[1];
+			y = params[1];
+			break;
+	}
+}
+
 void RandomArgs(Vector & initial, Vector & velocity, int type, double params[])
 {
 	//Initialise the random engine.
 	std::default_random_engine engine;
 	engine.seed(std::time(0));
 
+	RandomArgs(initial, velocity, type, params, engine);
+}
+
+void RandomArgs(Vector & initial, Vector & velocity, int type, double params[], std::default_random_engine & engine)
+{
 	//Temporary doubles to store output.
 	double temp, iX, iY;
 	
@@ -1264,10 +3976,102 @@ void Help()
 	printf("\nchaotic (and hence fractal) properties of the system. The regular data is more");
 	printf("\nuseful for observing other system properties.");
 	printf("\n");
+	printf("\nThe fractal can use adaptive angles: starting from an even grid, the angles are");
+	printf("\nrefined where the path length or the final wall hit jumps, up to the number of");
+	printf("\nangles asked for. This resolves the fractal edges with far fewer runs.");
+	printf("\n");
+	printf("\nRegular and chaotic plots can be run in double-double precision (about 32");
+	printf("\ndigits). A chaotic table doubles any rounding error every bounce or two, so a");
+	printf("\ndouble run is only accurate for a few dozen bounces; double-double lasts about");
+	printf("\ntwice as long, at roughly ten times the cost.");
+	printf("\n");
+	printf("\nThey can also run in double but stop when they are no longer trustworthy: the");
+	printf("\nball is shadowed in double-double, and the run stops where the two part. The");
+	printf("\npredictability horizon option measures this over many random balls.");
+	printf("\n");
+	printf("\nEvery bounce of a regular plot is checked: the numbers are finite, the ball");
+	printf("\nmoved forward, it hit the edge and kept its speed. By default the run stops at");
+	printf("\nthe first failure; set BILLIARDS_HEALTH to ignore (only count failures) or");
+	printf("\nrepair (put the state right and carry on) to change this.");
+	printf("\n");
+	printf("\nRegular plots can stop once the ball is on a periodic orbit, found by the");
+	printf("\nbounces coming back to the same place at the same angle several times over.");
+	printf("\n");
 	printf("\nThe third option is the chaotic analysis option, which takes two sets of initial");
 	printf("\nconditions (which should be close to each other) and generates data to observe");
 	printf("\nhow small changes to initial conditions affect the system.");
 	printf("\n");
+	printf("\nEscape statistics cut holes in the table edge and run many balls at once until");
+	printf("\nthey escape, giving escape time histograms and survival probabilities. Holes are");
+	printf("\ngiven as ranges of arc length round the table edge; the table help says where");
+	printf("\nthe arc length starts. The balls are run in parallel on all cores, or on the");
+	printf("\nnumber of threads in the BILLIARDS_THREADS environment variable.");
+	printf("\n");
+	printf("\nThe Lyapunov spectrum option carries small changes to the position and velocity");
+	printf("\nalong one trajectory using the curvature of the table at each bounce, and gives");
+	printf("\nthe rates at which they grow or shrink. The largest is positive for chaotic");
+	printf("\ntables (stadium, Lorentz) and zero for the circle, ellipse and rectangle.");
+	printf("\n");
+	printf("\nDivergence statistics run one trajectory plus many neighbours started a small");
+	printf("\nrandom distance away, and give the spread of the log distance to the neighbours");
+	printf("\nafter each bounce. The slope of the mean is the largest Lyapunov exponent per");
+	printf("\nbounce, until the distance reaches the size of the table.");
+	printf("\n");
+	printf("\nThe divergence time heatmap starts balls from a grid of points on the edge and");
+	printf("\nangles, and counts the bounces until a small change grows by a given factor.");
+	printf("\nChaotic regions come out dark, regular islands bright.");
+	printf("\n");
+	printf("\nThe parameter sweep runs a table over a range of one of its dimensions, with");
+	printf("\nseveral random starts at each, and writes the mean Lyapunov exponent, mean free");
+	printf("\npath and box dimension of the bounces for each value in one file.");
+	printf("\n");
+	printf("\nThe combined analysis runs one trajectory once and passes every bounce to the");
+	printf("\nanalyses chosen (raw output, free path histogram, Lyapunov spectrum, box");
+	printf("\ndimension, Poincare image, escape through holes, decay of correlations,");
+	printf("\nsymbolic itinerary), then shows the time each took.");
+	printf("\n");
+	printf("\nThe periodic orbit search spreads guesses over the Poincare section and refines");
+	printf("\neach with Newton's method until the ball comes back to the same bounce after the");
+	printf("\ngiven number of bounces. Each distinct orbit is listed with its length and the");
+	printf("\ntrace of its linearised map: stable if the trace is between -2 and 2. Orbits");
+	printf("\nwith a trace of exactly 2 or -2 come in families, which are listed once.");
+	printf("\n");
+	printf("\nThe ergodic averages option runs one ball until its mean free path and its");
+	printf("\ndistributions round the edge and in angle are known to a tolerance, as judged");
+	printf("\nfrom the spread of the averages over long stretches of the run, instead of for a");
+	printf("\nfixed number of bounces. The number of iterations is then only an upper limit.");
+	printf("\n");
+	printf("\nThe decay of correlations option follows how quickly the free path and the");
+	printf("\nposition round the edge forget their earlier values, up to a largest lag. The");
+	printf("\nstadium forgets slowly (its bouncing ball orbits), the Lorentz table quickly.");
+	printf("\n");
+	printf("\nThe mixing option starts many balls from one point in nearly the same direction");
+	printf("\nand looks at them at even steps in time, not at bounces. The entropy of how they");
+	printf("\nare spread over a grid of positions and directions shows how fast the table");
+	printf("\nmixes them; the mean squared distance from the start is written too.");
+	printf("\n");
+	printf("\nThe cloning option looks for the rare stretches of a run that are much more or");
+	printf("\nmuch less chaotic than usual. Many balls are run at once, and every few bounces");
+	printf("\nthose that stretched more (bias s > 0) or less (s < 0) are copied and the rest");
+	printf("\ndropped. psi(s) gives the odds of each Lyapunov exponent over a long run; at s = 0");
+	printf("\nit is 0 and the exponent is the usual one.");
+	printf("\n");
+	printf("\nThe symbolic dynamics option records only which wall is hit at each bounce, in");
+	printf("\n2 or 3 bits a bounce. Counting the different runs of walls of each length gives");
+	printf("\nthe entropy of the table per bounce, which for a chaotic table should be close");
+	printf("\nto its Lyapunov exponent, and the topological entropy.");
+	printf("\n");
+	printf("\nThe Poincare section runs many random trajectories and draws every bounce as a");
+	printf("\npoint in Birkhoff coordinates: arc length round the edge (across) against the");
+	printf("\nsine of the reflection angle (up). The density is written straight to an image.");
+	printf("\nIt can run in single precision, which is faster; the drift in speed and distance");
+	printf("\nfrom the edge is printed afterwards, with a warning if the image can't be trusted.");
+	printf("\n");
+	printf("\nThe density image option draws the ball path or the fractal plot straight into an");
+	printf("\nimage, which is much faster than plotting a large .dat file with the plotter.");
+	printf("\nThe fractal image can be written as a pyramid of 256 pixel tiles, level z having");
+	printf("\n2^z by 2^z tiles. Zooming into a tile only simulates the angles reaching it.");
+	printf("\n");
 	printf("\nEnter a menu choice (0 - 6) to see details or to exit help: ");
 	while (true)
 	{
@@ -1293,26 +4097,32 @@ void Help()
 				printf("The x and y geometry of the table (which is input by the user) corresponds to\n");
 				printf("the poisition of the top most corner of the rectangular part of the table.\n");
 				printf("I.e. the length of the rectangular table is 2x, and the width is 2y. The radius\n");
-				printf("of the semi-circles is then y, and the maximum length of the table is 2xy.\n\n");
+				printf("of the semi-circles is then y, and the maximum length of the table is 2xy.\n");
+				printf("Arc length round the edge starts at (x,-y) and runs anticlockwise.\n\n");
 				break;				
 			case 2:
 				printf("\nThe elliptical table is parameterised by two coefficients and a radius,\n");
 				printf("following the equation (x/a)^2 + (y/b)^2 = r^2. With a and b as the x and y\n");
-				printf("coefficients respectively.\n\n");
+				printf("coefficients respectively.\n");
+				printf("Arc length round the edge starts at (ra,0) and runs anticlockwise.\n\n");
 				break;
 			case 3:
 				printf("\nThe circular table's geometry is parameterised by a single value, its radius.\n");
-				printf("The circle then follows the equation x^2 + y^2 = r^2.\n\n");
+				printf("The circle then follows the equation x^2 + y^2 = r^2.\n");
+				printf("Arc length round the edge starts at (r,0) and runs anticlockwise.\n\n");
 				break;
 			case 4:
 				printf("\nThe rectangular table's geometry is specified by the coordinate of its top right\n");
 				printf("coordinate. I.e. x and y are input, which corresponds to a table with length 2x\n");
-				printf("and width 2y.\n\n");
+				printf("and width 2y.\n");
+				printf("Arc length round the edge starts at (x,-y) and runs anticlockwise.\n\n");
 				break;
 			case 5:
 				printf("\nThe Lorentz table is a rectangular table with a circle cut out of the middle.\n");
 				printf("The ball can therefore bounce of the inside walls of the rectangle, or the outside\n");
-				printf("walls of the inner circle. All possible trajectories are ergodic (apparently.)\n\n");
+				printf("walls of the inner circle. All possible trajectories are ergodic (apparently.)\n");
+				printf("Arc length runs round the rectangle as for the rectangular table, then clockwise\n");
+				printf("round the inner circle from (r,0).\n\n");
 			case 6:
 				printf("\n'Help' displays above message and then prompts for further help or to quit.\n\n");
 				break;